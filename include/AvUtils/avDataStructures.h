@@ -7,9 +7,14 @@ C_SYMBOLS_START
 
 #include "dataStructures/avQueue.h"
 #include "dataStructures/avGrid.h"
+#include "dataStructures/avSparseGrid.h"
 #include "dataStructures/avTable.h"
 #include "dataStructures/avDynamicArray.h"
 #include "dataStructures/avArray.h"
+#include "dataStructures/avConcurrentMap.h"
+#include "dataStructures/avConcurrentQueue.h"
+#include "dataStructures/avPriorityQueue.h"
+#include "dataStructures/avTimerWheel.h"
 //#include "avList.h"
 //#include "dataStructures/avFMap.h"
 
@@ -15,4 +15,22 @@
 #define AV_NULL_OPTION
 #define AV_EMPTY {0}
 
+#ifndef AV_CACHE_LINE_SIZE
+#define AV_CACHE_LINE_SIZE 64
+#endif
+
+// the library is built without optimization, hot loops are marked so they are compiled at O3 regardless.
+// AV_HOT_KERNEL_TARGET additionally enables instruction set extensions, such a function may only be
+// called after checking the cpu supports them
+#if defined(__GNUC__) && !defined(__clang__)
+#define AV_HOT_KERNEL __attribute__((optimize("O3")))
+#define AV_HOT_KERNEL_TARGET(features) __attribute__((target(features), optimize("O3")))
+#elif defined(__GNUC__)
+#define AV_HOT_KERNEL
+#define AV_HOT_KERNEL_TARGET(features) __attribute__((target(features)))
+#else
+#define AV_HOT_KERNEL
+#define AV_HOT_KERNEL_TARGET(features)
+#endif
+
 #endif//__AV_DEFINITIONS__
\ No newline at end of file
@@ -17,16 +17,21 @@ C_SYMBOLS_START
 
 typedef struct AvStringMemoryProperties {
 	bool8 heapAllocated;
+	bool8 shared; // references are counted atomically so strings of this memory can be used and freed from any thread
 	uint32 contextAllocationIndex; // for debugging purposes
 	uint32 allocationLine;
 	const char* allocationFile;
 	void* debugContext;
 } AvStringMemoryProperties;
+// memory of at most this many characters keeps them inside the AvStringMemory instead of a separate allocation
+#define AV_STRING_INLINE_CAPACITY 23
+
 typedef struct AvStringMemory {
-	char* data; // the characters
+	char* data; // the characters, points to inlineData for short strings
 	uint64 capacity; // the amount of characters allocated
 	uint64 referenceCount;
 	AvStringMemoryProperties properties;
+	char inlineData[AV_STRING_INLINE_CAPACITY + 1]; // short strings and their null terminator, the memory may not be moved while it is allocated
 } AvStringMemory;
 typedef AvStringMemory* AvStringHeapMemory;
 typedef AvStringMemory* AvStringMemoryRef;
@@ -58,6 +63,16 @@ void avStringCopySection(AvStringRef dst, uint64 offset, uint64 length, AvString
 
 void avStringFromMemory(AvStringRef dst, uint64 offset, uint64 length, AvStringMemoryRef memory);
 
+/// @brief switches the memory to atomic reference counting so its strings can be handed to other threads.
+/// the memory is no longer tracked by a debug context as it may be freed by any thread.
+/// call this on the thread that owns the memory before handing it over
+void avStringMemoryMakeShared(AvStringMemoryRef memory);
+
+/// @brief makes dst reference the same characters as src without copying them, the references are counted atomically from then on.
+/// dst can be freed on any thread. strings without memory are cloned as their lifetime is unknown
+#define avStringShare(dst, src) avStringShare_(dst, src, __FILE__, __LINE__)
+void avStringShare_(AvStringRef dst, AvString src, const char* file, uint32 line);
+
 
 
 /// @brief removes a reference from the string memory, freeing it 
@@ -114,12 +129,30 @@ void avStringMemoryAllocStore(AvString str, AvStringMemoryRef memory);
 #define avStringDebugContextEnd 
 #endif
 
+// debug contexts are kept per thread, a context only tracks memory allocated on the thread that started it.
+// memory is counted in the innermost context that is active when it is allocated, enclosing contexts do not see it.
+// tracking is O(1) per allocation, define AV_STRING_DEBUG_VALIDATE when building the library to check the whole context after every change
 void avStringDebugContextStart_();
 void avStringDebugContextEnd_();
 
+typedef struct AvStringDebugStats {
+	uint32 liveCount; // string memories allocated and not yet freed
+	uint64 liveBytes; // characters held by those memories
+	uint32 peakCount;
+	uint64 peakBytes;
+	uint64 totalAllocations; // every allocation made while the context was active
+} AvStringDebugStats;
+
+/// @brief reads the counters of the innermost debug context of the calling thread
+/// @return false if there is no active debug context
+bool32 avStringDebugContextGetStats(AvStringDebugStats* stats);
+
 strOffset avStringFindLastOccuranceOfChar(AvString str, char chr);
 strOffset avStringFindFirstOccranceOfChar(AvString str, char chr);
 uint64 avStringFindCharCount(AvString str, char chr);
+/// @brief finds the first character that is any of the given characters, sets of up to 16 characters are fastest
+strOffset avStringFindFirstOccuranceOfAny(AvString str, AvString chars);
+strOffset avStringFindLastOccuranceOfAny(AvString str, AvString chars);
 
 strOffset avStringFindLastOccuranceOf(AvString str, AvString find);
 strOffset avStringFindFirstOccuranceOf(AvString str, AvString find);
@@ -137,14 +170,26 @@ bool32 avStringStartsWithChar(AvString str, char chr);
 bool32 avStringWrite(AvStringRef str, strOffset offset, char chr);
 char avStringRead(AvString str, strOffset offset);
 
+// only the ascii letters change case
 void avStringToUppercase(AvStringRef str);
 void avStringToLowercase(AvStringRef str);
 
+/// @brief length of the leading characters that belong to any of the classes
+/// @param classes AV_CHAR_ class flags from string/avChar.h, for example AV_CHAR_IDENTIFIER
+uint64 avStringSpanClass(AvString str, byte classes);
+/// @brief length of the leading characters that belong to none of the classes
+uint64 avStringSpanNotClass(AvString str, byte classes);
+
 bool32 avStringEquals(AvString strA, AvString strB);
+/// @brief equality for strings whose avStringHash is already known, different hashes are rejected without reading the strings
+bool32 avStringEqualsHashed(AvString strA, uint64 hashA, AvString strB, uint64 hashB);
 int32 avStringCompare(AvString strA, AvString strB);
+// case insensitive functions only fold the ascii letters
 bool32 avStringEqualsCaseInsensitive(AvString strA, AvString strB);
+int32 avStringCompareCaseInsensitive(AvString strA, AvString strB);
 
 void avStringReplaceChar(AvStringRef str, char original, char replacement);
+/// @brief replaces every sequence with the replacement of the same index in one pass, matches are found leftmost-longest (see avStringMatcher.h)
 uint64 avStringReplaceAll(AvStringRef dst, AvString str, uint32 count, uint64 stride, AvString* sequences, AvString* replacements);
 uint64 avStringReplace(AvStringRef dst, AvString str, AvString sequence, AvString replacement);
 
@@ -156,6 +201,36 @@ void avStringJoin_(AvStringRef dst, ...);
 void avStringAppend(AvStringRef dst, AvString src);
 void avStringAppendChar(AvStringRef str, char c);
 
+/// @brief builds a string piece by piece in a buffer that grows geometrically, so appending is amortized O(1)
+typedef struct AvStringBuilder {
+	char* data; // the characters written so far, always followed by space for a null terminator
+	uint64 length; // the amount of characters written
+	uint64 capacity; // the amount of characters that fit before the buffer grows
+} AvStringBuilder;
+
+/// @brief creates an empty builder
+/// @param initialCapacity the amount of characters to reserve up front, may be 0
+void avStringBuilderCreate(uint64 initialCapacity, AvStringBuilder* builder);
+void avStringBuilderDestroy(AvStringBuilder* builder);
+
+/// @brief makes sure at least capacity characters fit without growing
+void avStringBuilderReserve(uint64 capacity, AvStringBuilder* builder);
+void avStringBuilderAppend(AvString str, AvStringBuilder* builder);
+void avStringBuilderAppendChar(char chr, AvStringBuilder* builder);
+void avStringBuilderAppendRepeat(char chr, uint64 count, AvStringBuilder* builder);
+/// @brief appends a formatted string, supports the same format codes as avStringPrintf
+void avStringBuilderAppendf(AvStringBuilder* builder, AvString format, ...);
+void avStringBuilderAppendfVA(AvStringBuilder* builder, AvString format, va_list args);
+/// @brief shortens the built string, lengths past the current length are ignored
+void avStringBuilderTruncate(uint64 length, AvStringBuilder* builder);
+void avStringBuilderClear(AvStringBuilder* builder);
+/// @brief a constant view of the built string, valid until the builder changes
+AvString avStringBuilderView(AvStringBuilder* builder);
+
+/// @brief hands the buffer of the builder over to a new string without copying it, the builder is left empty
+#define avStringBuilderFinish(dst, builder) avStringBuilderFinish_(dst, builder, __FILE__, __LINE__)
+void avStringBuilderFinish_(AvStringRef dst, AvStringBuilder* builder, const char* file, uint32 line);
+
 bool32 avStringIsEmpty(AvString str);
 
 #define avStringMemoryStoreCharArraysVA(result, ...) avStringMemoryStoreCharArraysVA_(result, __VA_ARGS__, NULL);
@@ -178,6 +253,39 @@ uint32 avStringScanf(AvString format, AvString str, ...);
 uint32 avStringSplitOnChar(AV_DS(AvArrayRef, AvString)substrings, char split, AvString str);
 uint32 avStringSplit(AV_DS(AvArrayRef, AvString) substrings, AvString split, AvString str);
 
+typedef enum AvStringSplitFlags {
+	AV_STRING_SPLIT_DEFAULT = 0,
+	AV_STRING_SPLIT_SKIP_EMPTY = 1 << 0, // fields between adjacent delimiters and at either end are not returned
+} AvStringSplitFlags;
+
+/// @brief walks the fields of a string without copying or allocating, every field is a constant view into the source.
+/// the source and delimiter strings must stay valid while iterating
+typedef struct AvStringSplitIterator {
+	const char* chrs;
+	uint64 length;
+	uint64 position; // start of the next field
+	const char* delimiter;
+	uint64 delimiterLength;
+	char delimiterChar;
+	uint32 maxSplits;
+	uint32 fieldCount; // fields returned so far
+	AvStringSplitFlags flags;
+	bool8 finished;
+} AvStringSplitIterator;
+
+/// @brief starts splitting str on every occurrence of delimiter
+/// @param delimiter a delimiter of any length, an empty delimiter returns the whole string as a single field
+/// @param maxSplits after this many fields the rest of the string is returned as the last field, 0 for no limit
+void avStringSplitIteratorCreate(AvString str, AvString delimiter, uint32 maxSplits, AvStringSplitFlags flags, AvStringSplitIterator* iterator);
+void avStringSplitIteratorCreateOnChar(AvString str, char delimiter, uint32 maxSplits, AvStringSplitFlags flags, AvStringSplitIterator* iterator);
+/// @brief moves to the next field
+/// @param substring receives a view of the field, it does not need to be freed
+/// @return false when there are no more fields
+bool32 avStringSplitNext(AvStringRef substring, AvStringSplitIterator* iterator);
+/// @brief fills a caller provided buffer with the next fields, call again to continue where the buffer ran out
+/// @return the amount of fields written, fewer than capacity means the string is exhausted
+uint32 avStringSplitNextBatch(AvString* substrings, uint32 capacity, AvStringSplitIterator* iterator);
+
 void avStringFlip(AvStringRef dst, AvString src);
 
 void avStringCopyToAllocator(AvString src, AvStringRef dst, AvAllocator* allocator);
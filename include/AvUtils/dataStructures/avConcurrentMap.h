@@ -0,0 +1,44 @@
+#ifndef __AV_CONCURRENT_MAP__
+#define __AV_CONCURRENT_MAP__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+typedef struct AvConcurrentMap_T* AvConcurrentMap;
+
+typedef uint64 (*AvConcurrentMapHashFunction)(const void* key, uint64 keySize);
+
+// called with the shard locked, data points to the stored value and may be modified in place
+typedef void (*AvConcurrentMapComputeCallback)(void* data, const void* key, void* userData);
+
+#define AV_CONCURRENT_MAP_DEFAULT_SHARD_COUNT 64
+
+// shardCount is rounded up to a power of two, 0 selects AV_CONCURRENT_MAP_DEFAULT_SHARD_COUNT
+// hashFunction may be null to use the default hash
+void avConcurrentMapCreate(uint64 keySize, uint64 dataSize, uint32 shardCount, AvConcurrentMapHashFunction hashFunction, AvConcurrentMap* map);
+void avConcurrentMapDestroy(AvConcurrentMap map);
+
+// lock free, copies the value into data (may be null), returns false if the key is not present
+bool32 avConcurrentMapRead(void* data, const void* key, AvConcurrentMap map);
+bool32 avConcurrentMapContains(const void* key, AvConcurrentMap map);
+
+// inserts or overwrites, returns true if the key was newly inserted
+bool32 avConcurrentMapWrite(const void* data, const void* key, AvConcurrentMap map);
+
+// returns true if the value was inserted, otherwise the present value is copied into existing (may be null)
+bool32 avConcurrentMapInsertIfAbsent(const void* data, const void* key, void* existing, AvConcurrentMap map);
+
+// runs the callback on the stored value while holding the shard lock, returns false if the key is not present
+bool32 avConcurrentMapComputeIfPresent(const void* key, AvConcurrentMapComputeCallback callback, void* userData, AvConcurrentMap map);
+
+bool32 avConcurrentMapRemove(const void* key, AvConcurrentMap map);
+void avConcurrentMapClear(AvConcurrentMap map);
+
+// sum of the shard counts, only exact when no writers are active
+uint64 avConcurrentMapGetCount(AvConcurrentMap map);
+uint64 avConcurrentMapGetKeySize(AvConcurrentMap map);
+uint64 avConcurrentMapGetDataSize(AvConcurrentMap map);
+
+C_SYMBOLS_END
+#endif//__AV_CONCURRENT_MAP__
@@ -0,0 +1,52 @@
+#ifndef __AV_CONCURRENT_QUEUE__
+#define __AV_CONCURRENT_QUEUE__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+// bounded lock free queues for passing elements between threads.
+// queueSize is rounded up to a power of two.
+
+// single producer, single consumer
+typedef struct AvSpscQueue_T* AvSpscQueue;
+
+void avSpscQueueCreate(uint64 elementSize, uint64 queueSize, AvSpscQueue* queue);
+void avSpscQueueDestroy(AvSpscQueue queue);
+
+// producer side, returns 0 if the queue is full
+bool8 avSpscQueuePush(const void* element, AvSpscQueue queue);
+// consumer side, returns 0 if the queue is empty
+bool8 avSpscQueuePull(void* element, AvSpscQueue queue);
+
+// pushes up to count contiguous elements, returns the number of elements pushed
+uint64 avSpscQueuePushBatch(const void* elements, uint64 count, AvSpscQueue queue);
+// pulls up to count elements, returns the number of elements pulled
+uint64 avSpscQueuePullBatch(void* elements, uint64 count, AvSpscQueue queue);
+
+// only a snapshot while the other side is active
+uint64 avSpscQueueGetOccupiedSpace(AvSpscQueue queue);
+uint64 avSpscQueueGetSize(AvSpscQueue queue);
+uint64 avSpscQueueGetElementSize(AvSpscQueue queue);
+
+
+// multiple producers, multiple consumers
+typedef struct AvMpmcQueue_T* AvMpmcQueue;
+
+void avMpmcQueueCreate(uint64 elementSize, uint64 queueSize, AvMpmcQueue* queue);
+void avMpmcQueueDestroy(AvMpmcQueue queue);
+
+bool8 avMpmcQueuePush(const void* element, AvMpmcQueue queue);
+bool8 avMpmcQueuePull(void* element, AvMpmcQueue queue);
+
+// claims up to count slots at once, returns the number of elements pushed
+uint64 avMpmcQueuePushBatch(const void* elements, uint64 count, AvMpmcQueue queue);
+// claims up to count filled slots at once, returns the number of elements pulled
+uint64 avMpmcQueuePullBatch(void* elements, uint64 count, AvMpmcQueue queue);
+
+uint64 avMpmcQueueGetOccupiedSpace(AvMpmcQueue queue);
+uint64 avMpmcQueueGetSize(AvMpmcQueue queue);
+uint64 avMpmcQueueGetElementSize(AvMpmcQueue queue);
+
+C_SYMBOLS_END
+#endif//__AV_CONCURRENT_QUEUE__
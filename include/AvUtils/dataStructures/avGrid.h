@@ -7,6 +7,18 @@ C_SYMBOLS_START
 
 typedef struct AvGrid_T* AvGrid;
 
+// edge length of the square tiles used by the tiled layouts and the tile iteration
+#define AV_GRID_TILE_SIZE 64
+
+typedef enum AvGridLayout {
+	// rows stored one after another
+	AV_GRID_LAYOUT_LINEAR,
+	// 64x64 tiles in row order, cells inside a tile in row order
+	AV_GRID_LAYOUT_TILED,
+	// 64x64 tiles in row order, cells inside a tile in z-order (morton order)
+	AV_GRID_LAYOUT_MORTON,
+} AvGridLayout;
+
 /// <summary>
 /// creates a grid instance
 /// </summary>
@@ -16,6 +28,14 @@ typedef struct AvGrid_T* AvGrid;
 /// <param name="grid">: the grid handle</param>
 void avGridCreate(uint64 elementSize, uint32 width, uint32 height, AvGrid* grid);
 
+/// <summary>
+/// creates a grid instance with the given memory layout.
+/// tiled layouts keep 2d neighbourhoods close in memory, which helps kernels that read neighbouring rows.
+/// the layout only affects performance, every function behaves the same for all layouts
+/// </summary>
+/// <param name="layout">: how the cells are stored</param>
+void avGridCreateLayout(AvGridLayout layout, uint64 elementSize, uint32 width, uint32 height, AvGrid* grid);
+
 /// <summary>
 /// write to the grid
 /// </summary>
@@ -54,17 +74,112 @@ void* avGridGetPtr(uint32 x, uint32 y, AvGrid grid);
 /// destroys the grid instance
 /// </summary>
 /// <param name="grid"></param>
+void avGridDestroy(AvGrid grid);
+// misspelled original name, kept for existing callers
 void aGridDestroy(AvGrid grid);
 
 uint32 avGridGetWidth(AvGrid grid);
 uint32 avGridGetHeight(AvGrid grid);
 uint64 avGridGetElementSize(AvGrid grid);
+AvGridLayout avGridGetLayout(AvGrid grid);
 
 void avGridWriteGrid(AvGrid src, uint32 x, uint32 y, uint32 width, uint32 height, AvGrid dst);
 
+/// <summary>
+/// copies a region between grids one row at a time, the region is clipped to both grids. src and dst may be the same grid
+/// </summary>
+/// <param name="src">: the source grid</param>
+/// <param name="srcX">: left of the region in the source</param>
+/// <param name="srcY">: top of the region in the source</param>
+/// <param name="width">: width of the region</param>
+/// <param name="height">: height of the region</param>
+/// <param name="dst">: the destination grid</param>
+/// <param name="dstX">: left of the region in the destination</param>
+/// <param name="dstY">: top of the region in the destination</param>
+void avGridCopyRegion(AvGrid src, uint32 srcX, uint32 srcY, uint32 width, uint32 height, AvGrid dst, uint32 dstX, uint32 dstY);
 
+/// <summary>
+/// sets every cell of a region, clipped to the grid
+/// </summary>
+/// <param name="data">: the fill value, nullptr fills with zeroes</param>
+void avGridFillRegion(const void* data, uint32 x, uint32 y, uint32 width, uint32 height, AvGrid grid);
 
+/// <summary>
+/// compares two equally sized regions bytewise
+/// </summary>
+/// <returns>true if the regions are equal, false if they differ or do not fit in their grids</returns>
+bool32 avGridCompareRegion(AvGrid gridA, uint32 xA, uint32 yA, uint32 width, uint32 height, AvGrid gridB, uint32 xB, uint32 yB);
+
+/// <summary>
+/// creates a new grid holding a copy of a region, clipped to the source grid
+/// </summary>
+/// <param name="dst">: receives the new grid, left untouched if the clipped region is empty</param>
+void avGridExtract(uint32 x, uint32 y, uint32 width, uint32 height, AvGrid src, AvGrid* dst);
+
+
+
+/// <summary>
+/// finds the smallest rectangle containing every cell equal to data.
+/// if no cell matches xMin and yMin are set to the grid size and xMax and yMax to 0
+/// </summary>
 void avGridFindMinRectSurrounding(void* data, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid);
 
+// returns true for cells that should be included
+typedef bool32 (*AvGridCellPredicate)(const void* cell, void* userData);
+// receives one contiguous row of width cells, returns false to stop the scan
+typedef bool32 (*AvGridRowCallback)(const void* row, uint32 width, uint32 y, void* userData);
+
+/// <summary>
+/// same as avGridFindMinRectSurrounding but cells are selected by a predicate
+/// </summary>
+/// <returns>true if any cell matched</returns>
+bool32 avGridFindMinRectMatching(AvGridCellPredicate predicate, void* userData, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid);
+
+/// <summary>
+/// calls the callback for the rows in [yStart, yEnd)
+/// </summary>
+/// <returns>the number of rows visited</returns>
+uint32 avGridScanRows(uint32 yStart, uint32 yEnd, AvGridRowCallback callback, void* userData, AvGrid grid);
+
+// a tile of at most AV_GRID_TILE_SIZE x AV_GRID_TILE_SIZE cells, tiles on the right and bottom edge are clipped to the grid
+typedef struct AvGridTile {
+	uint32 x;
+	uint32 y;
+	uint32 width;
+	uint32 height;
+	uint64 elementSize;
+	AvGridLayout layout;
+	// the first cell of the tile
+	void* data;
+	// bytes between the start of two rows, 0 for morton tiles whose rows are not contiguous
+	uint64 rowStride;
+} AvGridTile;
+
+// returns false to stop the iteration
+typedef bool32 (*AvGridTileCallback)(const AvGridTile* tile, void* userData);
+
+uint32 avGridGetTileCountX(AvGrid grid);
+uint32 avGridGetTileCountY(AvGrid grid);
+
+/// <summary>
+/// gets a tile by its tile coordinates, works for every layout
+/// </summary>
+/// <returns>false if the tile is outside the grid</returns>
+bool32 avGridGetTile(uint32 tileX, uint32 tileY, AvGridTile* tile, AvGrid grid);
+
+/// <summary>
+/// calls the callback for every tile in row order of tiles
+/// </summary>
+/// <returns>the number of tiles visited</returns>
+uint32 avGridForEachTile(AvGridTileCallback callback, void* userData, AvGrid grid);
+
+/// <summary>
+/// gets the pointer to a cell of a tile
+/// </summary>
+/// <param name="x">: column inside the tile</param>
+/// <param name="y">: row inside the tile</param>
+/// <returns>the pointer to the cell, nullptr if it is outside the tile</returns>
+void* avGridTileGetPtr(uint32 x, uint32 y, const AvGridTile* tile);
+
 C_SYMBOLS_END
 #endif//__AV_GRID__
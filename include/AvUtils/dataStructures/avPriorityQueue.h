@@ -0,0 +1,40 @@
+#ifndef __AV_PRIORITY_QUEUE__
+#define __AV_PRIORITY_QUEUE__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+// min-heap keyed on a uint64 priority, pop returns the lowest priority first.
+// use (UINT64_MAX - priority) to pop the highest priority first.
+typedef struct AvPriorityQueue_T* AvPriorityQueue;
+
+// identifies an element while it is in the queue, stale handles are detected and rejected
+typedef uint64 AvPriorityQueueHandle;
+#define AV_PRIORITY_QUEUE_INVALID_HANDLE ((AvPriorityQueueHandle)0)
+
+void avPriorityQueueCreate(uint64 elementSize, uint32 initialCapacity, AvPriorityQueue* queue);
+void avPriorityQueueDestroy(AvPriorityQueue queue);
+
+AvPriorityQueueHandle avPriorityQueuePush(const void* element, uint64 priority, AvPriorityQueue queue);
+
+// element and priority may be nullptr, returns 0 if the queue is empty
+bool8 avPriorityQueuePop(void* element, uint64* priority, AvPriorityQueue queue);
+bool8 avPriorityQueuePeek(void* element, uint64* priority, AvPriorityQueue queue);
+
+// changes the priority of a queued element, moving it up or down the heap
+bool8 avPriorityQueueUpdate(AvPriorityQueueHandle handle, uint64 priority, AvPriorityQueue queue);
+// removes a queued element, element may be nullptr
+bool8 avPriorityQueueRemove(AvPriorityQueueHandle handle, void* element, AvPriorityQueue queue);
+
+bool8 avPriorityQueueContains(AvPriorityQueueHandle handle, AvPriorityQueue queue);
+bool8 avPriorityQueueGetPriority(AvPriorityQueueHandle handle, uint64* priority, AvPriorityQueue queue);
+// pointer to the stored element, valid until the next push
+void* avPriorityQueueGetElementPtr(AvPriorityQueueHandle handle, AvPriorityQueue queue);
+
+void avPriorityQueueClear(AvPriorityQueue queue);
+uint32 avPriorityQueueGetCount(AvPriorityQueue queue);
+uint64 avPriorityQueueGetElementSize(AvPriorityQueue queue);
+
+C_SYMBOLS_END
+#endif//__AV_PRIORITY_QUEUE__
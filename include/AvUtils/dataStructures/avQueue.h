@@ -15,6 +15,14 @@ typedef struct AvQueue_T* AvQueue;
 /// <param name="queue">: the queue handle</param>
 void avQueueCreate(uint64 elementSize, uint64 queueSize, AvQueue* queue);
 
+/// <summary>
+/// creates a queue that doubles its allocation instead of rejecting elements when it is full
+/// </summary>
+/// <param name="elementSize">: the size of the elements in the queue</param>
+/// <param name="initialSize">: the amount of elements initially allocated, rounded up to a power of two</param>
+/// <param name="queue">: the queue handle</param>
+void avQueueCreateGrowable(uint64 elementSize, uint64 initialSize, AvQueue* queue);
+
 /// <summary>
 /// destroys the queue instance
 /// </summary>
@@ -65,6 +73,67 @@ bool8 avQueuePush(void* element, AvQueue queue);
 /// <returns>1 if the pull was successfull, 0 otherwise</returns>
 bool8 avQueuePull(void* element, AvQueue queue);
 
+/// <summary>
+/// adds an element in front of the oldest element, so it is pulled next
+/// </summary>
+/// <param name="element">: pointer to the element to be added, (must be a valid element)</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>1 if the push was successfull, 0 if not</returns>
+bool8 avQueuePushFront(void* element, AvQueue queue);
+
+/// <summary>
+/// retrieves the most recently pushed element
+/// </summary>
+/// <param name="element">: pointer to store the element in, (must be a valid element)</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>1 if the pull was successfull, 0 otherwise</returns>
+bool8 avQueuePullBack(void* element, AvQueue queue);
+
+/// <summary>
+/// adds count contiguous elements to the queue
+/// </summary>
+/// <param name="elements">: pointer to the elements to be added</param>
+/// <param name="count">: the number of elements</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>the number of elements pushed, less than count only when a fixed size queue runs full</returns>
+uint64 avQueuePushBatch(const void* elements, uint64 count, AvQueue queue);
+
+/// <summary>
+/// retrieves up to count elements from the queue
+/// </summary>
+/// <param name="elements">: buffer for at least count elements</param>
+/// <param name="count">: the maximum number of elements</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>the number of elements pulled</returns>
+uint64 avQueuePullBatch(void* elements, uint64 count, AvQueue queue);
+
+/// <summary>
+/// returns the queued elements in place as at most two contiguous spans, in pull order.
+/// the spans stay valid until the queue is modified
+/// </summary>
+/// <param name="first">: receives the oldest elements</param>
+/// <param name="firstCount">: receives the number of elements in the first span</param>
+/// <param name="second">: receives the wrapped around remainder, nullptr if there is none</param>
+/// <param name="secondCount">: receives the number of elements in the second span</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>the total number of elements</returns>
+uint64 avQueuePeekSpans(void** first, uint64* firstCount, void** second, uint64* secondCount, AvQueue queue);
+
+/// <summary>
+/// removes up to count elements from the front without copying them, used after consuming peeked spans
+/// </summary>
+/// <param name="count">: the number of elements to remove</param>
+/// <param name="queue">: the queue handle</param>
+/// <returns>the number of elements removed</returns>
+uint64 avQueueDiscard(uint64 count, AvQueue queue);
+
+/// <summary>
+/// makes sure count more elements fit without growing again, only affects growable queues
+/// </summary>
+/// <param name="count">: the number of elements about to be pushed</param>
+/// <param name="queue">: the queue handle</param>
+void avQueueReserve(uint64 count, AvQueue queue);
+
 /// <summary>
 /// returns the allocated number of elements
 /// </summary>
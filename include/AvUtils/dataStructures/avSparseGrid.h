@@ -0,0 +1,64 @@
+#ifndef __AV_SPARSE_GRID__
+#define __AV_SPARSE_GRID__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+// unbounded grid for mostly empty domains. cells are stored in square chunks that are allocated on the first write,
+// cells of unallocated chunks read as the default value. memory scales with the number of touched chunks
+typedef struct AvSparseGrid_T* AvSparseGrid;
+
+// edge length of a chunk in cells
+#define AV_SPARSE_GRID_CHUNK_SIZE 64
+
+// an allocated chunk, cells are stored row by row
+typedef struct AvSparseGridChunk {
+	uint32 chunkX;
+	uint32 chunkY;
+	// grid coordinates of the top left cell
+	uint32 x;
+	uint32 y;
+	void* data;
+	// bytes between the start of two rows
+	uint64 rowStride;
+} AvSparseGridChunk;
+
+// returns false to stop the iteration
+typedef bool32 (*AvSparseGridChunkCallback)(const AvSparseGridChunk* chunk, void* userData);
+
+/// @brief creates a sparse grid
+/// @param defaultValue value of untouched cells, nullptr for zeroes
+void avSparseGridCreate(uint64 elementSize, const void* defaultValue, AvSparseGrid* grid);
+void avSparseGridDestroy(AvSparseGrid grid);
+
+// writing allocates the chunk of the cell if needed
+void avSparseGridWrite(const void* data, uint32 x, uint32 y, AvSparseGrid grid);
+// reads the default value from unallocated chunks
+void avSparseGridRead(void* data, uint32 x, uint32 y, AvSparseGrid grid);
+
+// pointer to a cell, nullptr if its chunk is not allocated. valid until the chunk is released
+void* avSparseGridGetPtr(uint32 x, uint32 y, AvSparseGrid grid);
+// pointer to a cell, allocating its chunk if needed
+void* avSparseGridGetWritePtr(uint32 x, uint32 y, AvSparseGrid grid);
+
+bool32 avSparseGridIsAllocated(uint32 x, uint32 y, AvSparseGrid grid);
+
+/// @brief frees the chunk containing a cell, its cells read as the default value again
+/// @return false if the chunk was not allocated
+bool32 avSparseGridReleaseChunk(uint32 x, uint32 y, AvSparseGrid grid);
+// frees every chunk
+void avSparseGridClear(AvSparseGrid grid);
+
+/// @brief calls the callback for every allocated chunk in no particular order.
+/// the callback may modify cells but must not allocate or release chunks
+/// @return the number of chunks visited
+uint32 avSparseGridForEachChunk(AvSparseGridChunkCallback callback, void* userData, AvSparseGrid grid);
+
+uint32 avSparseGridGetChunkCount(AvSparseGrid grid);
+uint64 avSparseGridGetElementSize(AvSparseGrid grid);
+// bytes used by the chunks and the chunk table
+uint64 avSparseGridGetMemoryUsage(AvSparseGrid grid);
+
+C_SYMBOLS_END
+#endif//__AV_SPARSE_GRID__
@@ -8,9 +8,40 @@ C_SYMBOLS_START
 
 typedef struct AvTable_T* AvTable;
 
+typedef enum AvTableLayout {
+	// rows are stored contiguously
+	AV_TABLE_LAYOUT_ROWS = 0,
+	// every column is its own contiguous array, faster for scans that only touch a few columns
+	AV_TABLE_LAYOUT_COLUMNS,
+} AvTableLayout;
+
+// interpretation of a column for the reductions
+typedef enum AvTableElementType {
+	AV_TABLE_ELEMENT_TYPE_INT32,
+	AV_TABLE_ELEMENT_TYPE_UINT32,
+	AV_TABLE_ELEMENT_TYPE_INT64,
+	AV_TABLE_ELEMENT_TYPE_UINT64,
+	AV_TABLE_ELEMENT_TYPE_FLOAT,
+	AV_TABLE_ELEMENT_TYPE_DOUBLE,
+	// compared bytewise, only valid for indexes
+	AV_TABLE_ELEMENT_TYPE_BYTES,
+} AvTableElementType;
+
+typedef enum AvTableIndexType {
+	// rows ordered by value, supports equality and range queries in logarithmic time
+	AV_TABLE_INDEX_SORTED,
+	// hashed cell values, supports equality queries in constant time
+	AV_TABLE_INDEX_HASH,
+} AvTableIndexType;
 
 void avTableCreateFromArray(uint32 columns, uint32 rows, AvTable* table, uint64* columnSizes);
 void avTableCreate(uint32 columns, uint32 rows, AvTable* table, ...);
+void avTableCreateFromArrayLayout(AvTableLayout layout, uint32 columns, uint32 rows, AvTable* table, uint64* columnSizes);
+void avTableCreateLayout(AvTableLayout layout, uint32 columns, uint32 rows, AvTable* table, ...);
+
+AvTableLayout avTableGetLayout(AvTable table);
+// packed column array of a columnar table, nullptr for the row layout
+void* avTableGetColumnData(uint32 column, AvTable table);
 
 void avTableWrite(void* data, uint32 column, uint32 row, AvTable table);
 void avTableRead(void* data, uint32 column, uint32 row, AvTable table);
@@ -27,6 +58,42 @@ void avTableWriteColumn(void* data, uint32 column, AvTable table);
 void avTableReadRow(void* data, uint32 row, AvTable table);
 void avTableReadColumn(void* data, uint32 column, AvTable table);
 
+/// @brief adds up every value of a column
+/// @param sum receives an int64 for signed, a uint64 for unsigned and a double for floating point columns
+/// @return false if the element type does not match the column size
+bool32 avTableColumnSum(uint32 column, AvTableElementType type, void* sum, AvTable table);
+/// @brief finds the smallest and largest value of a column, min and max are of the element type and may be nullptr
+/// @return false if the table is empty or the element type does not match the column size
+bool32 avTableColumnMinMax(uint32 column, AvTableElementType type, void* min, void* max, AvTable table);
+/// @brief counts the cells that are bytewise equal to value
+uint64 avTableColumnCountEqual(uint32 column, const void* value, AvTable table);
+
+/// @brief builds an index over a column, replacing any existing index on it. Writes keep the index up to date
+/// @param elementType how values are ordered, a sorted index on AV_TABLE_ELEMENT_TYPE_BYTES orders them bytewise
+void avTableCreateIndex(uint32 column, AvTableIndexType type, AvTableElementType elementType, AvTable table);
+void avTableDestroyIndex(uint32 column, AvTable table);
+bool32 avTableHasIndex(uint32 column, AvTable table);
+
+/// @brief finds the rows whose cell is bytewise equal to value, uses the column index if there is one
+/// @param rows receives at most maxRows row numbers in ascending order for a sorted index, may be nullptr
+/// @return the total number of matching rows
+uint32 avTableFindEqual(uint32 column, const void* value, uint32* rows, uint32 maxRows, AvTable table);
+/// @brief finds the rows with a value in [low, high], ordered by value. Requires a sorted index on the column
+/// @return the total number of matching rows
+uint32 avTableFindRange(uint32 column, const void* low, const void* high, uint32* rows, uint32 maxRows, AvTable table);
+
+/// @brief makes room for at least rows rows so appending does not reallocate
+void avTableReserve(uint32 rows, AvTable table);
+/// @brief adds a row to the end of the table, growing it as needed
+/// @param data a packed row like avTableWriteRow takes, nullptr appends a zeroed row
+/// @return the index of the new row
+uint32 avTableAppendRow(void* data, AvTable table);
+/// @brief adds count rows at once, copying each column from its own packed buffer
+/// @param columns one buffer of count cells per column, a nullptr buffer or array zeroes the cells
+/// @return the index of the first new row
+uint32 avTableAppendRows(uint32 count, const void* const* columns, AvTable table);
+uint32 avTableGetCapacity(AvTable table);
+
 uint32 avTableGetColumns(AvTable table);
 uint32 avTableGetRows(AvTable table);
 
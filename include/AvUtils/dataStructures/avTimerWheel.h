@@ -0,0 +1,42 @@
+#ifndef __AV_TIMER_WHEEL__
+#define __AV_TIMER_WHEEL__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+// hierarchical timer wheel. time is measured in caller defined ticks,
+// insert and cancel are O(1) and timers only move down a level when their slot comes up.
+typedef struct AvTimerWheel_T* AvTimerWheel;
+
+typedef uint64 AvTimerHandle;
+#define AV_TIMER_INVALID_HANDLE ((AvTimerHandle)0)
+
+#define AV_TIMER_WHEEL_LEVEL_BITS 6
+#define AV_TIMER_WHEEL_LEVEL_COUNT 4
+
+// called for every expired timer, data points to the copy made at insertion
+typedef void (*AvTimerWheelCallback)(void* data, uint64 expiry, void* userData);
+
+void avTimerWheelCreate(uint64 dataSize, uint64 startTick, AvTimerWheel* wheel);
+void avTimerWheelDestroy(AvTimerWheel wheel);
+
+// timers with an expiry that already passed fire on the next advance
+AvTimerHandle avTimerWheelInsert(uint64 expiry, const void* data, AvTimerWheel wheel);
+bool8 avTimerWheelCancel(AvTimerHandle handle, AvTimerWheel wheel);
+
+/// @brief moves the wheel to the given tick and fires every timer that expired, one slot at a time
+/// @param now the new current tick, must not be earlier than the current tick
+/// @param callback may insert and cancel timers
+/// @return the number of fired timers
+uint32 avTimerWheelAdvance(uint64 now, AvTimerWheelCallback callback, void* userData, AvTimerWheel wheel);
+
+/// @brief finds the earliest pending expiry, for example to decide how long to sleep
+/// @return 0 if no timers are pending
+bool8 avTimerWheelGetNextExpiry(uint64* expiry, AvTimerWheel wheel);
+
+uint64 avTimerWheelGetTime(AvTimerWheel wheel);
+uint32 avTimerWheelGetCount(AvTimerWheel wheel);
+
+C_SYMBOLS_END
+#endif//__AV_TIMER_WHEEL__
@@ -3,6 +3,7 @@
 #include "../avDefinitions.h"
 C_SYMBOLS_START
 #include <AvUtils/avString.h>
+#include <AvUtils/string/avStringIntern.h>
 
 typedef struct AvToken {
     AvString text;
@@ -44,5 +45,8 @@ typedef struct AvTokenizeResult {
 
 AvTokenizeResult avTokenizeString(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules);
 
+/// @brief tokenizes like avTokenizeString, but the token texts are interned in the pool instead of cloned. Token texts can then be compared with avStringInternEquals
+AvTokenizeResult avTokenizeStringInterned(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules, AvStringInternPool pool);
+
 C_SYMBOLS_END
 #endif//_AV_TOKENIZER__
\ No newline at end of file
@@ -5,6 +5,23 @@ C_SYMBOLS_START
 
 #include "../avTypes.h"
 
+// character classes, bytes outside of ascii belong to none of them
+#define AV_CHAR_UPPERCASE (1 << 0)
+#define AV_CHAR_LOWERCASE (1 << 1)
+#define AV_CHAR_DIGIT (1 << 2)
+#define AV_CHAR_HEX (1 << 3) // 0-9, a-f and A-F
+#define AV_CHAR_SPACE (1 << 4) // space, tab, form feed and newlines
+#define AV_CHAR_NEWLINE (1 << 5) // \n and \r
+#define AV_CHAR_IDENTIFIER (1 << 6) // letters, digits and '_'
+#define AV_CHAR_LETTER (AV_CHAR_UPPERCASE | AV_CHAR_LOWERCASE)
+#define AV_CHAR_ALPHANUMERIC (AV_CHAR_LETTER | AV_CHAR_DIGIT)
+
+// the classes of every byte
+extern const byte avCharClassTable[256];
+
+/// @brief true if the character belongs to any of the classes
+#define avCharHasClass(chr, classes) ((avCharClassTable[(byte)(chr)] & (classes)) != 0)
+
 bool32 avCharIsWithinRange(char chr, char start, char end);
 
 bool32 avCharIsLetter(char chr);
@@ -0,0 +1,34 @@
+#ifndef __AV_STRING_INTERN__
+#define __AV_STRING_INTERN__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+#include "../avTypes.h"
+#include "../avString.h"
+
+typedef struct AvStringInternPool_T* AvStringInternPool;
+
+/// @brief creates a pool that stores one copy of every distinct string
+/// @param threadSafe guard the pool with a reader/writer lock so it can be shared between threads
+/// @param pool the pool handle
+void avStringInternPoolCreate(bool32 threadSafe, AvStringInternPool* pool);
+void avStringInternPoolDestroy(AvStringInternPool pool);
+
+/// @brief returns the unique interned copy of the string
+/// @return a constant string owned by the pool, valid until the pool is destroyed. Two interned strings are equal if and only if their chrs pointers are equal
+AvString avStringIntern(AvString str, AvStringInternPool pool);
+
+/// @brief interns count strings with a single lock acquisition, dst and src may alias
+void avStringInternBulk(AvString* dst, const AvString* src, uint32 count, AvStringInternPool pool);
+
+/// @brief looks up a string without inserting it
+/// @return false if the string has not been interned
+bool32 avStringInternLookup(AvString str, AvString* interned, AvStringInternPool pool);
+
+uint32 avStringInternPoolGetCount(AvStringInternPool pool);
+uint64 avStringInternPoolGetMemorySize(AvStringInternPool pool);
+
+/// @brief compares two strings returned by the same pool
+#define avStringInternEquals(strA, strB) ((strA).chrs == (strB).chrs)
+
+C_SYMBOLS_END
+#endif//__AV_STRING_INTERN__
@@ -0,0 +1,48 @@
+#ifndef __AV_STRING_MATCHER__
+#define __AV_STRING_MATCHER__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+#include "../avTypes.h"
+#include "../avString.h"
+
+// searches for a fixed set of patterns at once using an Aho-Corasick automaton.
+// the matcher is compiled once and can be reused for any number of strings
+typedef struct AvStringMatcher_T* AvStringMatcher;
+
+typedef struct AvStringMatch {
+	uint64 offset; // offset of the match in the searched string
+	uint64 length; // length of the matched pattern
+	uint32 pattern; // index of the matched pattern
+} AvStringMatch;
+
+// returns false to stop the iteration
+typedef bool32 (*AvStringMatchCallback)(AvStringMatch match, void* userData);
+
+/// @brief compiles the patterns into a matcher, the patterns are copied and may be freed afterwards
+/// @param count the amount of patterns
+/// @param stride the distance in bytes between two patterns, use sizeof(AvString) for a plain array
+/// @param patterns the patterns to search for, empty patterns never match and when a pattern occurs twice the first index is reported
+void avStringMatcherCreate(uint32 count, uint64 stride, const AvString* patterns, AvStringMatcher* matcher);
+void avStringMatcherDestroy(AvStringMatcher matcher);
+
+uint32 avStringMatcherGetPatternCount(AvStringMatcher matcher);
+
+// matches are found leftmost-longest: the match that starts first wins, of the matches starting there the longest wins.
+// searching continues after the end of the previous match, so reported matches never overlap
+
+/// @brief finds the first match at or after start
+/// @return false if there is no match
+bool32 avStringMatcherFind(AvString str, uint64 start, AvStringMatch* match, AvStringMatcher matcher);
+/// @brief calls the callback for every match in order
+/// @return the number of matches visited
+uint64 avStringMatcherForEach(AvStringMatchCallback callback, void* userData, AvString str, AvStringMatcher matcher);
+uint64 avStringMatcherCount(AvString str, AvStringMatcher matcher);
+
+/// @brief replaces every match with the replacement of the same index in a single pass
+/// @param dst an empty string that receives the result
+/// @param stride the distance in bytes between two replacements
+/// @return the amount of replaced matches
+uint64 avStringMatcherReplace(AvStringRef dst, AvString str, uint64 stride, const AvString* replacements, AvStringMatcher matcher);
+
+C_SYMBOLS_END
+#endif//__AV_STRING_MATCHER__
@@ -5,11 +5,19 @@ C_SYMBOLS_START
 
 #include "../avTypes.h"
 
+// returned by the find functions when no bit matches
+#define AV_BITFIELD_NOT_FOUND ((uint32)-1)
+
+// bits are stored in 64 bit words, bit i lives in words[i / 64] at position i % 64.
+// bits past bitCount in the last word are always 0
 typedef struct AvBitField {
     const uint32 bitCount;
-    uint8* const bits;
+    uint64* const words;
 } AvBitField;
 
+// returns false to stop the iteration
+typedef bool32 (*AvBitFieldCallback)(uint32 bit, void* userData);
+
 void avBitFieldCreate(uint32 bitCount, AvBitField* bitField);
 void avBitFieldDestroy(AvBitField* bitField);
 
@@ -23,6 +31,25 @@ uint32 avBitFieldCountZeros(AvBitField bitField);
 
 void avBitFieldWriteAll(bool8 state, AvBitField bitField);
 
+uint32 avBitFieldGetWordCount(AvBitField bitField);
+
+// the find functions return AV_BITFIELD_NOT_FOUND if there is no such bit
+uint32 avBitFieldFindFirstSet(AvBitField bitField);
+uint32 avBitFieldFindFirstClear(AvBitField bitField);
+// first set or clear bit at or after start
+uint32 avBitFieldFindNextSet(uint32 start, AvBitField bitField);
+uint32 avBitFieldFindNextClear(uint32 start, AvBitField bitField);
+
+/// @brief calls the callback for every set bit in ascending order
+/// @return the number of bits visited
+uint32 avBitFieldForEachSet(AvBitFieldCallback callback, void* userData, AvBitField bitField);
+
+// bulk operations store the result in dst. a src shorter than dst is treated as padded with zeroes
+void avBitFieldAnd(AvBitField dst, AvBitField src);
+void avBitFieldOr(AvBitField dst, AvBitField src);
+void avBitFieldXor(AvBitField dst, AvBitField src);
+// dst = dst & ~src
+void avBitFieldAndNot(AvBitField dst, AvBitField src);
 
 C_SYMBOLS_END
-#endif//__AV_TIME__
\ No newline at end of file
+#endif//__AV_BITFIELD__
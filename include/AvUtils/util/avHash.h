@@ -0,0 +1,47 @@
+#ifndef __AV_HASH__
+#define __AV_HASH__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+#include "../avString.h"
+#include "../filesystem/avFile.h"
+
+#define AV_HASH_DEFAULT_SEED 0
+
+#define AV_HASH_STATE_BLOCK_SIZE 48
+#define AV_HASH_STATE_HISTORY_SIZE 16
+
+/// @brief incremental hash state, produces the same result as avHash64 for the concatenated input
+typedef struct AvHashState {
+	uint64 seed;
+	uint64 see1;
+	uint64 see2;
+	uint64 totalLength;
+	uint64 bufferLength;
+	bool8 blocksProcessed;
+	byte buffer[AV_HASH_STATE_HISTORY_SIZE + AV_HASH_STATE_BLOCK_SIZE];
+} AvHashState;
+
+/// @brief fast non-cryptographic 64 bit hash (wyhash construction)
+uint64 avHash64(const void* data, uint64 size, uint64 seed);
+
+/// @brief hashes a 64 bit integer, cheaper than avHash64 for single integer keys
+uint64 avHashU64(uint64 value);
+
+void avHashStateInit(uint64 seed, AvHashState* state);
+void avHashStateUpdate(const void* data, uint64 size, AvHashState* state);
+uint64 avHashStateFinal(const AvHashState* state);
+
+/// @brief hashes the contents of a file, the file is opened and closed if it is not open for reading
+/// @return false if the file could not be read
+bool32 avHashFile(AvFile file, uint64 seed, uint64* hash);
+
+/// @brief crc32c (castagnoli), uses the SSE4.2 crc32 instruction when the cpu supports it
+/// @param crc the crc of the preceding data, 0 for the first call
+uint32 avCrc32c(const void* data, uint64 size, uint32 crc);
+
+uint64 avStringHash(AvString str);
+
+C_SYMBOLS_END
+#endif//__AV_HASH__
@@ -0,0 +1,62 @@
+#ifndef __AV_ROARING_BITMAP__
+#define __AV_ROARING_BITMAP__
+#include "../avDefinitions.h"
+C_SYMBOLS_START
+
+#include "../avTypes.h"
+
+// compressed set of uint32 values. the value range is split into 64K chunks keyed on the upper 16 bits,
+// each chunk is stored as a sorted array, a 8KB bitmap or a list of runs, whichever fits its contents
+typedef struct AvRoaringBitmap_T* AvRoaringBitmap;
+
+// returns false to stop the iteration
+typedef bool32 (*AvRoaringBitmapCallback)(uint32 value, void* userData);
+
+void avRoaringBitmapCreate(AvRoaringBitmap* bitmap);
+void avRoaringBitmapDestroy(AvRoaringBitmap bitmap);
+void avRoaringBitmapClone(AvRoaringBitmap src, AvRoaringBitmap* dst);
+void avRoaringBitmapClear(AvRoaringBitmap bitmap);
+
+// return true if the set changed
+bool32 avRoaringBitmapAdd(uint32 value, AvRoaringBitmap bitmap);
+bool32 avRoaringBitmapRemove(uint32 value, AvRoaringBitmap bitmap);
+bool32 avRoaringBitmapContains(uint32 value, AvRoaringBitmap bitmap);
+
+// adds every value in [first, last], chunks that are covered completely become a single run
+void avRoaringBitmapAddRange(uint32 first, uint32 last, AvRoaringBitmap bitmap);
+
+// O(1), the cardinality is kept up to date by every operation
+uint64 avRoaringBitmapGetCardinality(AvRoaringBitmap bitmap);
+// return false if the bitmap is empty
+bool32 avRoaringBitmapGetMinimum(uint32* value, AvRoaringBitmap bitmap);
+bool32 avRoaringBitmapGetMaximum(uint32* value, AvRoaringBitmap bitmap);
+
+/// @brief calls the callback for every value in ascending order
+/// @return the number of values visited
+uint64 avRoaringBitmapForEach(AvRoaringBitmapCallback callback, void* userData, AvRoaringBitmap bitmap);
+
+// set operations store the result in dst, src is left untouched. dst and src may not be the same bitmap
+void avRoaringBitmapAnd(AvRoaringBitmap dst, AvRoaringBitmap src);
+void avRoaringBitmapOr(AvRoaringBitmap dst, AvRoaringBitmap src);
+void avRoaringBitmapXor(AvRoaringBitmap dst, AvRoaringBitmap src);
+// dst = dst - src
+void avRoaringBitmapAndNot(AvRoaringBitmap dst, AvRoaringBitmap src);
+bool32 avRoaringBitmapEquals(AvRoaringBitmap a, AvRoaringBitmap b);
+
+// converts chunks to run lists where that is smaller, call after building a set with long consecutive ranges
+void avRoaringBitmapRunOptimize(AvRoaringBitmap bitmap);
+
+// bytes used by the chunks and their bookkeeping
+uint64 avRoaringBitmapGetMemoryUsage(AvRoaringBitmap bitmap);
+
+// the serialized form stores numbers in the byte order of the host
+uint64 avRoaringBitmapGetSerializedSize(AvRoaringBitmap bitmap);
+/// @brief writes the serialized bitmap to buffer
+/// @return the number of bytes written, 0 if the buffer is too small
+uint64 avRoaringBitmapSerialize(void* buffer, uint64 size, AvRoaringBitmap bitmap);
+/// @brief creates a bitmap from its serialized form
+/// @return false if the data is not a valid serialized bitmap, bitmap is left untouched in that case
+bool32 avRoaringBitmapDeserialize(const void* buffer, uint64 size, AvRoaringBitmap* bitmap);
+
+C_SYMBOLS_END
+#endif//__AV_ROARING_BITMAP__
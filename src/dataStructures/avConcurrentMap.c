@@ -0,0 +1,394 @@
+#include <AvUtils/dataStructures/avConcurrentMap.h>
+#include <AvUtils/threading/avMutex.h>
+#include <AvUtils/threading/avThread.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/avLogging.h>
+#include <AvUtils/util/avHash.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define SHARD_INITIAL_CAPACITY 16
+#define SLOT_EMPTY 0
+#define SLOT_TOMBSTONE 1
+#define SLOT_HASH_MIN 2
+#define READ_SPIN_COUNT 64
+
+// each slot stores [hash][key][data], a hash of 0 or 1 marks an empty or removed slot
+typedef struct Table {
+	uint64 capacity;
+	uint64 mask;
+	byte* slots;
+	struct Table* retired;
+} Table;
+
+// readers never lock, they validate against the sequence which is odd while a writer is active.
+// tables replaced by a resize are retired instead of freed so a racing reader never touches freed memory.
+// only growing retires a table, so the retired tables together are never larger than the current one
+typedef struct Shard {
+	_Atomic uint64 sequence;
+	Table* _Atomic table;
+	_Atomic uint64 count;
+	uint64 tombstones;
+	AvMutex lock;
+	Table* retired;
+} Shard;
+
+typedef union PaddedShard {
+	Shard shard;
+	byte padding[(sizeof(Shard) + AV_CACHE_LINE_SIZE - 1) & ~(uint64)(AV_CACHE_LINE_SIZE - 1)];
+} PaddedShard;
+
+typedef struct AvConcurrentMap_T {
+	AvConcurrentMapHashFunction hash;
+	uint64 keySize;
+	uint64 dataSize;
+	uint64 slotSize;
+	uint32 shardCount;
+	uint32 shardShift;
+	PaddedShard* shards;
+	void* shardMemory;
+} AvConcurrentMap_T;
+
+static uint64 defaultHashFunction(const void* key, uint64 keySize) {
+	return avHash64(key, keySize, AV_HASH_DEFAULT_SEED);
+}
+
+static uint64 hashKey(const void* key, AvConcurrentMap map) {
+	uint64 hash = map->hash(key, map->keySize);
+	return hash < SLOT_HASH_MIN ? hash + SLOT_HASH_MIN : hash;
+}
+
+static Shard* getShard(uint64 hash, AvConcurrentMap map) {
+	if (map->shardCount == 1) {
+		return &map->shards[0].shard;
+	}
+	return &map->shards[hash >> map->shardShift].shard;
+}
+
+static byte* getSlot(uint64 index, Table* table, AvConcurrentMap map) {
+	return table->slots + index * map->slotSize;
+}
+
+static uint64* slotHash(byte* slot) {
+	return (uint64*)slot;
+}
+
+static byte* slotKey(byte* slot) {
+	return slot + sizeof(uint64);
+}
+
+static byte* slotData(byte* slot, AvConcurrentMap map) {
+	return slot + sizeof(uint64) + map->keySize;
+}
+
+static Table* createTable(uint64 capacity, AvConcurrentMap map) {
+	Table* table = avCallocate(1, sizeof(Table), "allocating concurrent map table");
+	table->capacity = capacity;
+	table->mask = capacity - 1;
+	table->slots = avCallocate(capacity, map->slotSize, "allocating concurrent map slots");
+	return table;
+}
+
+static void destroyTable(Table* table) {
+	avFree(table->slots);
+	avFree(table);
+}
+
+static byte* findSlot(uint64 hash, const void* key, Table* table, AvConcurrentMap map) {
+	uint64 index = hash & table->mask;
+	for (uint64 probe = 0; probe < table->capacity; probe++) {
+		byte* slot = getSlot(index, table, map);
+		uint64 slotHashValue = *slotHash(slot);
+		if (slotHashValue == SLOT_EMPTY) {
+			return nullptr;
+		}
+		if (slotHashValue == hash && memcmp(slotKey(slot), key, map->keySize) == 0) {
+			return slot;
+		}
+		index = (index + 1) & table->mask;
+	}
+	return nullptr;
+}
+
+// returns the first reusable slot for the key, only valid while holding the shard lock
+static byte* findInsertSlot(uint64 hash, Table* table, AvConcurrentMap map) {
+	uint64 index = hash & table->mask;
+	for (uint64 probe = 0; probe < table->capacity; probe++) {
+		byte* slot = getSlot(index, table, map);
+		if (*slotHash(slot) < SLOT_HASH_MIN) {
+			return slot;
+		}
+		index = (index + 1) & table->mask;
+	}
+	return nullptr;
+}
+
+static void beginWrite(Shard* shard) {
+	uint64 sequence = atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+	atomic_store_explicit(&shard->sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+}
+
+static void endWrite(Shard* shard) {
+	uint64 sequence = atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+	atomic_store_explicit(&shard->sequence, sequence + 1, memory_order_release);
+}
+
+static void rehash(uint64 capacity, Shard* shard, AvConcurrentMap map) {
+	Table* oldTable = atomic_load_explicit(&shard->table, memory_order_relaxed);
+	Table* newTable = createTable(capacity, map);
+	for (uint64 i = 0; i < oldTable->capacity; i++) {
+		byte* slot = getSlot(i, oldTable, map);
+		uint64 hash = *slotHash(slot);
+		if (hash < SLOT_HASH_MIN) {
+			continue;
+		}
+		memcpy(findInsertSlot(hash, newTable, map), slot, map->slotSize);
+	}
+	oldTable->retired = shard->retired;
+	shard->retired = oldTable;
+	shard->tombstones = 0;
+	atomic_store_explicit(&shard->table, newTable, memory_order_release);
+}
+
+// rebuilds the table in place without its tombstones. readers racing the rebuild fail their sequence
+// check and retry, and the table itself stays allocated, so nothing has to be retired
+static void purgeTombstones(Shard* shard, AvConcurrentMap map) {
+	Table* table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+	uint64 count = atomic_load_explicit(&shard->count, memory_order_relaxed);
+	byte* live = count ? avAllocate(count * map->slotSize, "allocating concurrent map purge buffer") : nullptr;
+	uint64 liveCount = 0;
+	for (uint64 i = 0; i < table->capacity; i++) {
+		byte* slot = getSlot(i, table, map);
+		if (*slotHash(slot) >= SLOT_HASH_MIN) {
+			memcpy(live + liveCount++ * map->slotSize, slot, map->slotSize);
+		}
+	}
+	memset(table->slots, 0, table->capacity * map->slotSize);
+	for (uint64 i = 0; i < liveCount; i++) {
+		byte* slot = live + i * map->slotSize;
+		memcpy(findInsertSlot(*slotHash(slot), table, map), slot, map->slotSize);
+	}
+	if (live) {
+		avFree(live);
+	}
+	shard->tombstones = 0;
+}
+
+// must be called between beginWrite and endWrite
+static void reserveSlot(Shard* shard, AvConcurrentMap map) {
+	Table* table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+	uint64 count = atomic_load_explicit(&shard->count, memory_order_relaxed);
+	if ((count + shard->tombstones + 1) * 4 <= table->capacity * 3) {
+		return;
+	}
+	if ((count + 1) * 2 <= table->capacity) {
+		purgeTombstones(shard, map);
+		return;
+	}
+	rehash(table->capacity * 2, shard, map);
+}
+
+static void insertLocked(uint64 hash, const void* data, const void* key, Shard* shard, AvConcurrentMap map) {
+	reserveSlot(shard, map);
+	Table* table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+	byte* slot = findInsertSlot(hash, table, map);
+	avAssert(slot != nullptr, "concurrent map shard is full");
+	if (*slotHash(slot) == SLOT_TOMBSTONE) {
+		shard->tombstones--;
+	}
+	memcpy(slotKey(slot), key, map->keySize);
+	memcpy(slotData(slot, map), data, map->dataSize);
+	*slotHash(slot) = hash;
+	atomic_fetch_add_explicit(&shard->count, 1, memory_order_relaxed);
+}
+
+void avConcurrentMapCreate(uint64 keySize, uint64 dataSize, uint32 shardCount, AvConcurrentMapHashFunction hashFunction, AvConcurrentMap* map) {
+	avAssert(map != nullptr, "map must be a valid reference");
+	if (keySize == 0 || dataSize == 0) {
+		avAssert(keySize != 0 && dataSize != 0, "key and data size must be non zero");
+		return;
+	}
+	if (shardCount == 0) {
+		shardCount = AV_CONCURRENT_MAP_DEFAULT_SHARD_COUNT;
+	}
+	shardCount = nextPow2(shardCount);
+
+	(*map) = avCallocate(1, sizeof(AvConcurrentMap_T), "allocating concurrent map handle");
+	(*map)->hash = hashFunction == nullptr ? &defaultHashFunction : hashFunction;
+	(*map)->keySize = keySize;
+	(*map)->dataSize = dataSize;
+	(*map)->slotSize = (sizeof(uint64) + keySize + dataSize + 7) & ~7ULL;
+	(*map)->shardCount = shardCount;
+	(*map)->shardShift = 64 - __builtin_ctz(shardCount);
+
+	(*map)->shardMemory = avCallocate(shardCount + 1, sizeof(PaddedShard), "allocating concurrent map shards");
+	uint64 address = ((uint64)(*map)->shardMemory + AV_CACHE_LINE_SIZE - 1) & ~(uint64)(AV_CACHE_LINE_SIZE - 1);
+	(*map)->shards = (PaddedShard*)address;
+
+	for (uint32 i = 0; i < shardCount; i++) {
+		Shard* shard = &(*map)->shards[i].shard;
+		atomic_init(&shard->sequence, 0);
+		atomic_init(&shard->count, 0);
+		atomic_init(&shard->table, createTable(SHARD_INITIAL_CAPACITY, *map));
+		shard->tombstones = 0;
+		shard->retired = nullptr;
+		avMutexCreate(&shard->lock);
+	}
+}
+
+void avConcurrentMapDestroy(AvConcurrentMap map) {
+	for (uint32 i = 0; i < map->shardCount; i++) {
+		Shard* shard = &map->shards[i].shard;
+		destroyTable(atomic_load(&shard->table));
+		Table* retired = shard->retired;
+		while (retired) {
+			Table* next = retired->retired;
+			destroyTable(retired);
+			retired = next;
+		}
+		avMutexDestroy(shard->lock);
+	}
+	avFree(map->shardMemory);
+	avFree(map);
+}
+
+bool32 avConcurrentMapRead(void* data, const void* key, AvConcurrentMap map) {
+	uint64 hash = hashKey(key, map);
+	Shard* shard = getShard(hash, map);
+	uint32 spins = 0;
+	while (true) {
+		uint64 sequence = atomic_load_explicit(&shard->sequence, memory_order_acquire);
+		if (sequence & 1) {
+			if (++spins > READ_SPIN_COUNT) {
+				avThreadYield();
+				spins = 0;
+			}
+			continue;
+		}
+		Table* table = atomic_load_explicit(&shard->table, memory_order_acquire);
+		byte* slot = findSlot(hash, key, table, map);
+		if (slot && data) {
+			memcpy(data, slotData(slot, map), map->dataSize);
+		}
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&shard->sequence, memory_order_relaxed) == sequence) {
+			return slot != nullptr;
+		}
+	}
+}
+
+bool32 avConcurrentMapContains(const void* key, AvConcurrentMap map) {
+	return avConcurrentMapRead(nullptr, key, map);
+}
+
+bool32 avConcurrentMapWrite(const void* data, const void* key, AvConcurrentMap map) {
+	uint64 hash = hashKey(key, map);
+	Shard* shard = getShard(hash, map);
+	avMutexLock(shard->lock);
+	beginWrite(shard);
+
+	bool32 inserted = false;
+	byte* slot = findSlot(hash, key, atomic_load_explicit(&shard->table, memory_order_relaxed), map);
+	if (slot) {
+		memcpy(slotData(slot, map), data, map->dataSize);
+	} else {
+		insertLocked(hash, data, key, shard, map);
+		inserted = true;
+	}
+
+	endWrite(shard);
+	avMutexUnlock(shard->lock);
+	return inserted;
+}
+
+bool32 avConcurrentMapInsertIfAbsent(const void* data, const void* key, void* existing, AvConcurrentMap map) {
+	uint64 hash = hashKey(key, map);
+	Shard* shard = getShard(hash, map);
+	avMutexLock(shard->lock);
+
+	byte* slot = findSlot(hash, key, atomic_load_explicit(&shard->table, memory_order_relaxed), map);
+	if (slot) {
+		if (existing) {
+			memcpy(existing, slotData(slot, map), map->dataSize);
+		}
+		avMutexUnlock(shard->lock);
+		return false;
+	}
+
+	beginWrite(shard);
+	insertLocked(hash, data, key, shard, map);
+	endWrite(shard);
+	avMutexUnlock(shard->lock);
+	return true;
+}
+
+bool32 avConcurrentMapComputeIfPresent(const void* key, AvConcurrentMapComputeCallback callback, void* userData, AvConcurrentMap map) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	uint64 hash = hashKey(key, map);
+	Shard* shard = getShard(hash, map);
+	avMutexLock(shard->lock);
+
+	byte* slot = findSlot(hash, key, atomic_load_explicit(&shard->table, memory_order_relaxed), map);
+	if (slot == nullptr) {
+		avMutexUnlock(shard->lock);
+		return false;
+	}
+
+	beginWrite(shard);
+	callback(slotData(slot, map), slotKey(slot), userData);
+	endWrite(shard);
+	avMutexUnlock(shard->lock);
+	return true;
+}
+
+bool32 avConcurrentMapRemove(const void* key, AvConcurrentMap map) {
+	uint64 hash = hashKey(key, map);
+	Shard* shard = getShard(hash, map);
+	avMutexLock(shard->lock);
+
+	byte* slot = findSlot(hash, key, atomic_load_explicit(&shard->table, memory_order_relaxed), map);
+	if (slot == nullptr) {
+		avMutexUnlock(shard->lock);
+		return false;
+	}
+
+	beginWrite(shard);
+	*slotHash(slot) = SLOT_TOMBSTONE;
+	shard->tombstones++;
+	atomic_fetch_sub_explicit(&shard->count, 1, memory_order_relaxed);
+	endWrite(shard);
+	avMutexUnlock(shard->lock);
+	return true;
+}
+
+void avConcurrentMapClear(AvConcurrentMap map) {
+	for (uint32 i = 0; i < map->shardCount; i++) {
+		Shard* shard = &map->shards[i].shard;
+		avMutexLock(shard->lock);
+		beginWrite(shard);
+		Table* table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+		memset(table->slots, 0, table->capacity * map->slotSize);
+		atomic_store_explicit(&shard->count, 0, memory_order_relaxed);
+		shard->tombstones = 0;
+		endWrite(shard);
+		avMutexUnlock(shard->lock);
+	}
+}
+
+uint64 avConcurrentMapGetCount(AvConcurrentMap map) {
+	uint64 count = 0;
+	for (uint32 i = 0; i < map->shardCount; i++) {
+		count += atomic_load_explicit(&map->shards[i].shard.count, memory_order_relaxed);
+	}
+	return count;
+}
+
+uint64 avConcurrentMapGetKeySize(AvConcurrentMap map) {
+	return map->keySize;
+}
+
+uint64 avConcurrentMapGetDataSize(AvConcurrentMap map) {
+	return map->dataSize;
+}
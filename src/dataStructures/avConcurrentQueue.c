@@ -0,0 +1,251 @@
+#include <AvUtils/dataStructures/avConcurrentQueue.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+#include <stdatomic.h>
+
+// the producer and consumer positions live on separate cache lines,
+// each side keeps a cached copy of the other position to avoid touching the shared line on every operation
+typedef struct AvSpscQueue_T {
+	byte* data;
+	uint64 elementSize;
+	uint64 size;
+	uint64 mask;
+	byte padding0[AV_CACHE_LINE_SIZE];
+
+	_Atomic uint64 head;
+	uint64 cachedTail;
+	byte padding1[AV_CACHE_LINE_SIZE];
+
+	_Atomic uint64 tail;
+	uint64 cachedHead;
+	byte padding2[AV_CACHE_LINE_SIZE];
+} AvSpscQueue_T;
+
+// every cell carries a sequence number (Vyukov bounded queue).
+// a cell at position p is free for a producer when its sequence equals p and filled when it equals p + 1
+typedef struct AvMpmcQueue_T {
+	byte* cells;
+	uint64 elementSize;
+	uint64 cellSize;
+	uint64 size;
+	uint64 mask;
+	byte padding0[AV_CACHE_LINE_SIZE];
+
+	_Atomic uint64 enqueuePos;
+	byte padding1[AV_CACHE_LINE_SIZE];
+
+	_Atomic uint64 dequeuePos;
+	byte padding2[AV_CACHE_LINE_SIZE];
+} AvMpmcQueue_T;
+
+static uint64 getCapacity(uint64 queueSize) {
+	return queueSize < 2 ? 2 : nextPow2L(queueSize);
+}
+
+// copies count elements into the ring starting at index, wrapping at most once
+static void ringWrite(byte* ring, uint64 index, const byte* elements, uint64 count, uint64 size, uint64 elementSize) {
+	uint64 first = AV_MIN(count, size - index);
+	memcpy(ring + index * elementSize, elements, first * elementSize);
+	memcpy(ring, elements + first * elementSize, (count - first) * elementSize);
+}
+
+static void ringRead(byte* elements, const byte* ring, uint64 index, uint64 count, uint64 size, uint64 elementSize) {
+	uint64 first = AV_MIN(count, size - index);
+	memcpy(elements, ring + index * elementSize, first * elementSize);
+	memcpy(elements + first * elementSize, ring, (count - first) * elementSize);
+}
+
+void avSpscQueueCreate(uint64 elementSize, uint64 queueSize, AvSpscQueue* queue) {
+	if (elementSize == 0 || queueSize == 0) {
+		return;
+	}
+	uint64 size = getCapacity(queueSize);
+	(*queue) = avCallocate(1, sizeof(AvSpscQueue_T), "allocating handle for spsc queue");
+	(*queue)->data = avCallocate(size, elementSize, "allocating spsc queue data");
+	(*queue)->elementSize = elementSize;
+	(*queue)->size = size;
+	(*queue)->mask = size - 1;
+	atomic_init(&(*queue)->head, 0);
+	atomic_init(&(*queue)->tail, 0);
+}
+
+void avSpscQueueDestroy(AvSpscQueue queue) {
+	avFree(queue->data);
+	avFree(queue);
+}
+
+uint64 avSpscQueuePushBatch(const void* elements, uint64 count, AvSpscQueue queue) {
+	avAssert(elements != nullptr || count == 0, "elements must be a valid pointer");
+	uint64 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+	uint64 free = queue->size - (tail - queue->cachedHead);
+	if (free < count) {
+		queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+		free = queue->size - (tail - queue->cachedHead);
+	}
+	count = AV_MIN(count, free);
+	if (count == 0) {
+		return 0;
+	}
+	ringWrite(queue->data, tail & queue->mask, elements, count, queue->size, queue->elementSize);
+	atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+	return count;
+}
+
+uint64 avSpscQueuePullBatch(void* elements, uint64 count, AvSpscQueue queue) {
+	avAssert(elements != nullptr || count == 0, "elements must be a valid pointer");
+	uint64 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	uint64 available = queue->cachedTail - head;
+	if (available < count) {
+		queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+		available = queue->cachedTail - head;
+	}
+	count = AV_MIN(count, available);
+	if (count == 0) {
+		return 0;
+	}
+	ringRead(elements, queue->data, head & queue->mask, count, queue->size, queue->elementSize);
+	atomic_store_explicit(&queue->head, head + count, memory_order_release);
+	return count;
+}
+
+bool8 avSpscQueuePush(const void* element, AvSpscQueue queue) {
+	if (element == NULL) {
+		return 0;
+	}
+	return avSpscQueuePushBatch(element, 1, queue) == 1;
+}
+
+bool8 avSpscQueuePull(void* element, AvSpscQueue queue) {
+	if (element == NULL) {
+		return 0;
+	}
+	return avSpscQueuePullBatch(element, 1, queue) == 1;
+}
+
+uint64 avSpscQueueGetOccupiedSpace(AvSpscQueue queue) {
+	uint64 head = atomic_load_explicit(&queue->head, memory_order_acquire);
+	uint64 tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+	return tail - head;
+}
+
+uint64 avSpscQueueGetSize(AvSpscQueue queue) {
+	return queue->size;
+}
+
+uint64 avSpscQueueGetElementSize(AvSpscQueue queue) {
+	return queue->elementSize;
+}
+
+static _Atomic uint64* cellSequence(uint64 position, AvMpmcQueue queue) {
+	return (_Atomic uint64*)(queue->cells + (position & queue->mask) * queue->cellSize);
+}
+
+static byte* cellData(uint64 position, AvMpmcQueue queue) {
+	return queue->cells + (position & queue->mask) * queue->cellSize + sizeof(uint64);
+}
+
+void avMpmcQueueCreate(uint64 elementSize, uint64 queueSize, AvMpmcQueue* queue) {
+	if (elementSize == 0 || queueSize == 0) {
+		return;
+	}
+	uint64 size = getCapacity(queueSize);
+	(*queue) = avCallocate(1, sizeof(AvMpmcQueue_T), "allocating handle for mpmc queue");
+	(*queue)->elementSize = elementSize;
+	(*queue)->cellSize = (sizeof(uint64) + elementSize + 7) & ~7ULL;
+	(*queue)->size = size;
+	(*queue)->mask = size - 1;
+	(*queue)->cells = avCallocate(size, (*queue)->cellSize, "allocating mpmc queue cells");
+	for (uint64 i = 0; i < size; i++) {
+		atomic_init(cellSequence(i, *queue), i);
+	}
+	atomic_init(&(*queue)->enqueuePos, 0);
+	atomic_init(&(*queue)->dequeuePos, 0);
+}
+
+void avMpmcQueueDestroy(AvMpmcQueue queue) {
+	avFree(queue->cells);
+	avFree(queue);
+}
+
+// claims up to count cells whose sequence equals position + offset, starting at the shared position counter.
+// a cell in the expected state can only change once another thread moves the counter past it,
+// so a successful exchange of the counter grants ownership of every scanned cell
+static uint64 claimCells(_Atomic uint64* counter, uint64 offset, uint64 count, uint64* start, AvMpmcQueue queue) {
+	uint64 position = atomic_load_explicit(counter, memory_order_relaxed);
+	while (true) {
+		uint64 claimable = 0;
+		bool32 stale = false;
+		while (claimable < count) {
+			uint64 expected = position + claimable + offset;
+			uint64 sequence = atomic_load_explicit(cellSequence(position + claimable, queue), memory_order_acquire);
+			if (sequence != expected) {
+				stale = (int64)(sequence - expected) > 0;
+				break;
+			}
+			claimable++;
+		}
+		if (claimable == 0) {
+			if (!stale) {
+				return 0;
+			}
+			position = atomic_load_explicit(counter, memory_order_relaxed);
+			continue;
+		}
+		if (atomic_compare_exchange_weak_explicit(counter, &position, position + claimable, memory_order_relaxed, memory_order_relaxed)) {
+			*start = position;
+			return claimable;
+		}
+	}
+}
+
+uint64 avMpmcQueuePushBatch(const void* elements, uint64 count, AvMpmcQueue queue) {
+	avAssert(elements != nullptr || count == 0, "elements must be a valid pointer");
+	uint64 start = 0;
+	count = claimCells(&queue->enqueuePos, 0, AV_MIN(count, queue->size), &start, queue);
+	for (uint64 i = 0; i < count; i++) {
+		memcpy(cellData(start + i, queue), (const byte*)elements + i * queue->elementSize, queue->elementSize);
+		atomic_store_explicit(cellSequence(start + i, queue), start + i + 1, memory_order_release);
+	}
+	return count;
+}
+
+uint64 avMpmcQueuePullBatch(void* elements, uint64 count, AvMpmcQueue queue) {
+	avAssert(elements != nullptr || count == 0, "elements must be a valid pointer");
+	uint64 start = 0;
+	count = claimCells(&queue->dequeuePos, 1, AV_MIN(count, queue->size), &start, queue);
+	for (uint64 i = 0; i < count; i++) {
+		memcpy((byte*)elements + i * queue->elementSize, cellData(start + i, queue), queue->elementSize);
+		atomic_store_explicit(cellSequence(start + i, queue), start + i + queue->size, memory_order_release);
+	}
+	return count;
+}
+
+bool8 avMpmcQueuePush(const void* element, AvMpmcQueue queue) {
+	if (element == NULL) {
+		return 0;
+	}
+	return avMpmcQueuePushBatch(element, 1, queue) == 1;
+}
+
+bool8 avMpmcQueuePull(void* element, AvMpmcQueue queue) {
+	if (element == NULL) {
+		return 0;
+	}
+	return avMpmcQueuePullBatch(element, 1, queue) == 1;
+}
+
+uint64 avMpmcQueueGetOccupiedSpace(AvMpmcQueue queue) {
+	uint64 dequeuePos = atomic_load_explicit(&queue->dequeuePos, memory_order_acquire);
+	uint64 enqueuePos = atomic_load_explicit(&queue->enqueuePos, memory_order_acquire);
+	return enqueuePos > dequeuePos ? AV_MIN(enqueuePos - dequeuePos, queue->size) : 0;
+}
+
+uint64 avMpmcQueueGetSize(AvMpmcQueue queue) {
+	return queue->size;
+}
+
+uint64 avMpmcQueueGetElementSize(AvMpmcQueue queue) {
+	return queue->elementSize;
+}
@@ -1,5 +1,6 @@
 #include <AvUtils/dataStructures/avFMap.h>
 #include <AvUtils/avMemory.h>
+#include <AvUtils/util/avHash.h>
 #include <string.h>
 
 
@@ -15,11 +16,7 @@ typedef struct AvFMap_T {
 } AvFMap_T; 
 
 static uint32 defaultHashFunction(void* data, uint64 dataSize, uint32 mapSize) {
-	byte* ch = (byte*)data;
-	int i, sum;
-	for (sum = 0, i = 0; i < dataSize; i++)
-		sum += ch[i];
-	return sum % mapSize;
+	return (uint32)(avHash64(data, dataSize, AV_HASH_DEFAULT_SEED) % mapSize);
 }
 
 void avFMapCreate(uint32 size, uint64 dataSize, uint64 keySize, HashFunction hashFunction, AvFMap* map) {
@@ -4,15 +4,40 @@
 #include <AvUtils/avMath.h>
 #include <string.h>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AV_GRID_SSE2
+#include <emmintrin.h>
+#endif
+
+#define GRID_KERNEL_INLINE static inline __attribute__((always_inline))
+
+#define TILE_BITS 6
+#define TILE_MASK (AV_GRID_TILE_SIZE - 1)
+#define TILE_CELLS (AV_GRID_TILE_SIZE * AV_GRID_TILE_SIZE)
 
 typedef struct AvGrid_T {
 	const byte* data;
 	const uint64 elementSize;
 	const uint32 width;
 	const uint32 height;
+	const AvGridLayout layout;
+	// tiles per row of tiles, only used by the tiled layouts
+	const uint32 tilesX;
 } AvGrid_T;
 
+// spreads the 6 bits of a tile coordinate over the even bits, morton index = spread[x] | spread[y] << 1
+static const uint16 mortonSpread[AV_GRID_TILE_SIZE] = {
+	0x000, 0x001, 0x004, 0x005, 0x010, 0x011, 0x014, 0x015, 0x040, 0x041, 0x044, 0x045, 0x050, 0x051, 0x054, 0x055,
+	0x100, 0x101, 0x104, 0x105, 0x110, 0x111, 0x114, 0x115, 0x140, 0x141, 0x144, 0x145, 0x150, 0x151, 0x154, 0x155,
+	0x400, 0x401, 0x404, 0x405, 0x410, 0x411, 0x414, 0x415, 0x440, 0x441, 0x444, 0x445, 0x450, 0x451, 0x454, 0x455,
+	0x500, 0x501, 0x504, 0x505, 0x510, 0x511, 0x514, 0x515, 0x540, 0x541, 0x544, 0x545, 0x550, 0x551, 0x554, 0x555,
+};
+
 void avGridCreate(uint64 elementSize, uint32 width, uint32 height, AvGrid* grid) {
+	avGridCreateLayout(AV_GRID_LAYOUT_LINEAR, elementSize, width, height, grid);
+}
+
+void avGridCreateLayout(AvGridLayout layout, uint64 elementSize, uint32 width, uint32 height, AvGrid* grid) {
 	if (elementSize == 0) {
 		return;
 	}
@@ -20,13 +45,22 @@ void avGridCreate(uint64 elementSize, uint32 width, uint32 height, AvGrid* grid)
 		return;
 	}
 	uint64 elementCount = (uint64)width * (uint64)height;
+	uint32 tilesX = 0;
+	if (layout != AV_GRID_LAYOUT_LINEAR) {
+		// tiled layouts pad the grid to whole tiles
+		tilesX = (width + TILE_MASK) >> TILE_BITS;
+		uint64 tilesY = (height + TILE_MASK) >> TILE_BITS;
+		elementCount = tilesX * tilesY * TILE_CELLS;
+	}
 
 	(*grid) = avAllocate(sizeof(AvGrid_T), "allocating grid handle");
 	AvGrid_T tmpGrid = {
 		.data = avCallocate(elementCount, elementSize, "allocating grid memory"),
 		.elementSize = elementSize,
 		.width = width,
-		.height = height
+		.height = height,
+		.layout = layout,
+		.tilesX = tilesX,
 	};
 	memcpy(*grid, &tmpGrid, sizeof(AvGrid_T));
 }
@@ -36,7 +70,16 @@ static bool32 checkBounds(uint32 x, uint32 y, AvGrid grid) {
 }
 
 static uint64 getIndex(uint32 x, uint32 y, AvGrid grid) {
-	return (uint64)y * (uint64)grid->width + (uint64)x;
+	if (grid->layout == AV_GRID_LAYOUT_LINEAR) {
+		return (uint64)y * (uint64)grid->width + (uint64)x;
+	}
+	uint64 tile = (uint64)(y >> TILE_BITS) * grid->tilesX + (x >> TILE_BITS);
+	uint32 localX = x & TILE_MASK;
+	uint32 localY = y & TILE_MASK;
+	if (grid->layout == AV_GRID_LAYOUT_TILED) {
+		return tile * TILE_CELLS + ((localY << TILE_BITS) | localX);
+	}
+	return tile * TILE_CELLS + (mortonSpread[localX] | (mortonSpread[localY] << 1));
 }
 
 static void* getPtr(uint32 x, uint32 y, AvGrid grid) {
@@ -44,9 +87,44 @@ static void* getPtr(uint32 x, uint32 y, AvGrid grid) {
 }
 
 static uint64 getElementCount(AvGrid grid) {
+	if (grid->layout != AV_GRID_LAYOUT_LINEAR) {
+		return (uint64)grid->tilesX * ((grid->height + TILE_MASK) >> TILE_BITS) * TILE_CELLS;
+	}
 	return (uint64)grid->width * (uint64)grid->height;
 }
 
+// returns count cells of row y starting at x, in place for linear grids and gathered into buffer otherwise
+static const byte* getRow(uint32 x, uint32 y, uint32 count, byte* buffer, AvGrid grid) {
+	if (grid->layout == AV_GRID_LAYOUT_LINEAR) {
+		return getPtr(x, y, grid);
+	}
+	uint64 elementSize = grid->elementSize;
+	byte* dst = buffer;
+	while (count) {
+		// a tiled row is contiguous up to the tile edge, a morton row only cell by cell
+		uint32 span = grid->layout == AV_GRID_LAYOUT_TILED ? AV_MIN(count, AV_GRID_TILE_SIZE - (x & TILE_MASK)) : 1;
+		memcpy(dst, getPtr(x, y, grid), span * elementSize);
+		dst += span * elementSize;
+		x += span;
+		count -= span;
+	}
+	return buffer;
+}
+
+static void putRow(const byte* src, uint32 x, uint32 y, uint32 count, AvGrid grid) {
+	uint64 elementSize = grid->elementSize;
+	while (count) {
+		uint32 span = count;
+		if (grid->layout != AV_GRID_LAYOUT_LINEAR) {
+			span = grid->layout == AV_GRID_LAYOUT_TILED ? AV_MIN(count, AV_GRID_TILE_SIZE - (x & TILE_MASK)) : 1;
+		}
+		memmove(getPtr(x, y, grid), src, span * elementSize);
+		src += span * elementSize;
+		x += span;
+		count -= span;
+	}
+}
+
 void avGridWrite(void* data, uint32 x, uint32 y, AvGrid grid) {
 	if (!checkBounds(x, y, grid)) {
 		return;
@@ -73,12 +151,7 @@ void avGridClear(void* data, AvGrid grid) {
 		memset((void*)grid->data, 0, getElementCount(grid) * grid->elementSize);
 		return;
 	}
-
-	for (uint32 y = 0; y < grid->height; y++) {
-		for (uint32 x = 0; x < grid->width; x++) {
-			avGridWrite(data, x, y, grid);
-		}
-	}
+	avGridFillRegion(data, 0, 0, grid->width, grid->height, grid);
 }
 
 void* avGridGetPtr(uint32 x, uint32 y, AvGrid grid) {
@@ -88,11 +161,15 @@ void* avGridGetPtr(uint32 x, uint32 y, AvGrid grid) {
 	return getPtr(x, y, grid);
 }
 
-void aGridDestroy(AvGrid grid) {
+void avGridDestroy(AvGrid grid) {
 	avFree((void*)grid->data);
 	avFree(grid);
 }
 
+void aGridDestroy(AvGrid grid) {
+	avGridDestroy(grid);
+}
+
 
 uint32 avGridGetWidth(AvGrid grid) {
 	return grid->width;
@@ -102,47 +179,375 @@ uint32 avGridGetHeight(AvGrid grid) {
 	return grid->height;
 }
 
+AvGridLayout avGridGetLayout(AvGrid grid) {
+	return grid->layout;
+}
+
 uint64 avGridGetElementSize(AvGrid grid) {
 	return grid->elementSize;
 }
 
+// clips a region starting at (x, y) to the grid, returns false if nothing is left
+static bool32 clipRegion(uint32 x, uint32 y, uint32* width, uint32* height, AvGrid grid) {
+	if (x >= grid->width || y >= grid->height) {
+		return false;
+	}
+	*width = AV_MIN(*width, grid->width - x);
+	*height = AV_MIN(*height, grid->height - y);
+	return *width != 0 && *height != 0;
+}
+
 void avGridWriteGrid(AvGrid src, uint32 x, uint32 y, uint32 width, uint32 height, AvGrid dst) {
 	avAssert(src != nullptr, "source must be a valid grid");
 	avAssert(dst != nullptr, "destination must be a valid grid");
-	avAssert(src->elementSize == dst->elementSize, "element size must be equal");
 	avAssert(width != 0 || height != 0, "cannot copy zero size region");
 
+	avGridCopyRegion(src, 0, 0, width, height, dst, x, y);
+}
 
-	if (x >= dst->width || y >= dst->height) {
+void avGridCopyRegion(AvGrid src, uint32 srcX, uint32 srcY, uint32 width, uint32 height, AvGrid dst, uint32 dstX, uint32 dstY) {
+	avAssert(src != nullptr, "source must be a valid grid");
+	avAssert(dst != nullptr, "destination must be a valid grid");
+	avAssert(src->elementSize == dst->elementSize, "element size must be equal");
+
+	if (!clipRegion(srcX, srcY, &width, &height, src) || !clipRegion(dstX, dstY, &width, &height, dst)) {
 		return;
 	}
-	width = AV_MIN(AV_MIN(width, src->width), x - dst->width);
-	height = AV_MIN(AV_MIN(height, src->height), y + dst->height);
+	uint64 rowSize = width * src->elementSize;
+	bool32 linear = src->layout == AV_GRID_LAYOUT_LINEAR && dst->layout == AV_GRID_LAYOUT_LINEAR;
+	byte* buffer = linear ? nullptr : avAllocate(rowSize, "allocating grid row buffer");
+	// copying within one grid walks the rows away from the overlap, memmove handles overlap inside a row
+	bool32 reverse = src == dst && dstY > srcY;
+	for (uint32 i = 0; i < height; i++) {
+		uint32 row = reverse ? height - 1 - i : i;
+		if (linear) {
+			memmove(getPtr(dstX, dstY + row, dst), getPtr(srcX, srcY + row, src), rowSize);
+		} else {
+			putRow(getRow(srcX, srcY + row, width, buffer, src), dstX, dstY + row, width, dst);
+		}
+	}
+	if (buffer) {
+		avFree(buffer);
+	}
+}
 
-	for (uint32 yy = 0; yy < height; yy++) {
-		for (uint32 xx = 0; xx < width; xx++) {
-			avGridRead(avGridGetPtr(xx + x, yy + y, dst), xx, yy, src);
+void avGridFillRegion(const void* data, uint32 x, uint32 y, uint32 width, uint32 height, AvGrid grid) {
+	if (!clipRegion(x, y, &width, &height, grid)) {
+		return;
+	}
+	uint64 rowSize = width * grid->elementSize;
+	bool32 linear = grid->layout == AV_GRID_LAYOUT_LINEAR;
+	byte* firstRow = linear ? getPtr(x, y, grid) : avAllocate(rowSize, "allocating grid row buffer");
+	if (data == nullptr) {
+		memset(firstRow, 0, rowSize);
+	} else {
+		// fill the first row by doubling the filled part, then copy it to the other rows
+		memcpy(firstRow, data, grid->elementSize);
+		uint64 filled = grid->elementSize;
+		while (filled < rowSize) {
+			uint64 size = AV_MIN(filled, rowSize - filled);
+			memcpy(firstRow + filled, firstRow, size);
+			filled += size;
+		}
+	}
+	if (!linear) {
+		for (uint32 row = 0; row < height; row++) {
+			putRow(firstRow, x, y + row, width, grid);
 		}
+		avFree(firstRow);
+		return;
+	}
+	for (uint32 row = 1; row < height; row++) {
+		memcpy(getPtr(x, y + row, grid), firstRow, rowSize);
 	}
 }
 
+bool32 avGridCompareRegion(AvGrid gridA, uint32 xA, uint32 yA, uint32 width, uint32 height, AvGrid gridB, uint32 xB, uint32 yB) {
+	avAssert(gridA != nullptr, "grid must be a valid grid");
+	avAssert(gridB != nullptr, "grid must be a valid grid");
+	if (gridA->elementSize != gridB->elementSize) {
+		return false;
+	}
+	if ((uint64)xA + width > gridA->width || (uint64)yA + height > gridA->height) {
+		return false;
+	}
+	if ((uint64)xB + width > gridB->width || (uint64)yB + height > gridB->height) {
+		return false;
+	}
+	uint64 rowSize = width * gridA->elementSize;
+	byte* bufferA = gridA->layout == AV_GRID_LAYOUT_LINEAR ? nullptr : avAllocate(rowSize, "allocating grid row buffer");
+	byte* bufferB = gridB->layout == AV_GRID_LAYOUT_LINEAR ? nullptr : avAllocate(rowSize, "allocating grid row buffer");
+	bool32 equal = true;
+	for (uint32 row = 0; row < height && equal; row++) {
+		equal = memcmp(getRow(xA, yA + row, width, bufferA, gridA), getRow(xB, yB + row, width, bufferB, gridB), rowSize) == 0;
+	}
+	if (bufferA) {
+		avFree(bufferA);
+	}
+	if (bufferB) {
+		avFree(bufferB);
+	}
+	return equal;
+}
 
-void avGridFindMinRectSurrounding(void* data, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid) {
+void avGridExtract(uint32 x, uint32 y, uint32 width, uint32 height, AvGrid src, AvGrid* dst) {
+	avAssert(src != nullptr, "source must be a valid grid");
+	if (!clipRegion(x, y, &width, &height, src)) {
+		return;
+	}
+	avGridCreateLayout(src->layout, src->elementSize, width, height, dst);
+	avGridCopyRegion(src, x, y, width, height, *dst, 0, 0);
+}
+
+// selects cells either by bytewise equality or through a predicate
+typedef struct CellMatcher {
+	const byte* pattern;
+	uint64 elementSize;
+	AvGridCellPredicate predicate;
+	void* userData;
+} CellMatcher;
+
+#ifdef AV_GRID_SSE2
+// bit mask with the lowest bit of every matching element in a 16 byte block set
+GRID_KERNEL_INLINE uint32 matchBlock(const byte* block, __m128i needle, uint64 elementSize) {
+	__m128i x = _mm_loadu_si128((const __m128i*)block);
+	switch (elementSize) {
+		case 1:
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(x, needle));
+		case 2:
+			return _mm_movemask_epi8(_mm_cmpeq_epi16(x, needle)) & 0x5555;
+		case 4:
+			return _mm_movemask_epi8(_mm_cmpeq_epi32(x, needle)) & 0x1111;
+		default: {
+			// a 64 bit lane matches when both of its 32 bit halves do
+			__m128i equal = _mm_cmpeq_epi32(x, needle);
+			equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_movemask_epi8(equal) & 0x0101;
+		}
+	}
+}
+
+GRID_KERNEL_INLINE __m128i makeNeedle(const byte* pattern, uint64 elementSize) {
+	uint64 value = 0;
+	memcpy(&value, pattern, elementSize);
+	switch (elementSize) {
+		case 1: return _mm_set1_epi8((char)value);
+		case 2: return _mm_set1_epi16((short)value);
+		case 4: return _mm_set1_epi32((int)value);
+		default: return _mm_set1_epi64x((long long)value);
+	}
+}
+#endif
+
+static bool32 isVectorSize(uint64 elementSize) {
+	return elementSize == 1 || elementSize == 2 || elementSize == 4 || elementSize == 8;
+}
+
+static bool32 matchCell(const byte* cell, const CellMatcher* matcher) {
+	if (matcher->predicate) {
+		return matcher->predicate(cell, matcher->userData);
+	}
+	return memcmp(cell, matcher->pattern, matcher->elementSize) == 0;
+}
+
+// index of the first matching cell in [begin, end) of a row, end if there is none
+AV_HOT_KERNEL static uint32 findFirstInRow(const byte* row, uint32 begin, uint32 end, const CellMatcher* matcher) {
+	uint64 elementSize = matcher->elementSize;
+	uint32 x = begin;
+#ifdef AV_GRID_SSE2
+	if (matcher->predicate == nullptr && isVectorSize(elementSize)) {
+		__m128i needle = makeNeedle(matcher->pattern, elementSize);
+		uint32 perBlock = 16 / elementSize;
+		for (; x + perBlock <= end; x += perBlock) {
+			uint32 mask = matchBlock(row + x * elementSize, needle, elementSize);
+			if (mask) {
+				return x + __builtin_ctz(mask) / elementSize;
+			}
+		}
+	}
+#endif
+	for (; x < end; x++) {
+		if (matchCell(row + x * elementSize, matcher)) {
+			return x;
+		}
+	}
+	return end;
+}
+
+// index of the last matching cell in [begin, end) of a row, end if there is none
+AV_HOT_KERNEL static uint32 findLastInRow(const byte* row, uint32 begin, uint32 end, const CellMatcher* matcher) {
+	uint64 elementSize = matcher->elementSize;
+	uint32 x = end;
+#ifdef AV_GRID_SSE2
+	if (matcher->predicate == nullptr && isVectorSize(elementSize)) {
+		__m128i needle = makeNeedle(matcher->pattern, elementSize);
+		uint32 perBlock = 16 / elementSize;
+		for (; x >= begin + perBlock; x -= perBlock) {
+			uint32 mask = matchBlock(row + (x - perBlock) * elementSize, needle, elementSize);
+			if (mask) {
+				return x - perBlock + (31 - __builtin_clz(mask)) / elementSize;
+			}
+		}
+	}
+#endif
+	while (x > begin) {
+		x--;
+		if (matchCell(row + x * elementSize, matcher)) {
+			return x;
+		}
+	}
+	return end;
+}
+
+// rows are searched from the top and bottom until a match is found, the rows in between
+// only need to be searched left of the current minimum and right of the current maximum
+static bool32 findMinRectRows(const CellMatcher* matcher, byte* buffer, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid) {
+
+	uint32 top = 0;
+	uint32 first = grid->width;
+	for (; top < grid->height; top++) {
+		first = findFirstInRow(getRow(0, top, grid->width, buffer, grid), 0, grid->width, matcher);
+		if (first != grid->width) {
+			break;
+		}
+	}
+	if (top == grid->height) {
+		return false;
+	}
+	uint32 bottom = grid->height - 1;
+	while (bottom > top && findFirstInRow(getRow(0, bottom, grid->width, buffer, grid), 0, grid->width, matcher) == grid->width) {
+		bottom--;
+	}
+
+	uint32 left = first;
+	uint32 right = findLastInRow(getRow(0, top, grid->width, buffer, grid), first, grid->width, matcher);
+	for (uint32 y = top + 1; y <= bottom && (left > 0 || right < grid->width - 1); y++) {
+		const byte* row = getRow(0, y, grid->width, buffer, grid);
+		uint32 found = findFirstInRow(row, 0, left, matcher);
+		if (found != left) {
+			left = found;
+		}
+		found = findLastInRow(row, right + 1, grid->width, matcher);
+		if (found != grid->width) {
+			right = found;
+		}
+	}
+	*xMin = left;
+	*yMin = top;
+	*xMax = right;
+	*yMax = bottom;
+	return true;
+}
+
+static bool32 findMinRect(const CellMatcher* matcher, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid) {
 	*xMin = grid->width;
 	*yMin = grid->height;
 	*xMax = 0;
 	*yMax = 0;
-	void* tmpData = avAllocate(grid->elementSize, "allocating temp data");
-	for (uint32 v = 0; v < grid->height; v++) {
-		for (uint32 u = 0; u < grid->width; u++) {
-			avGridRead(tmpData, u, v, grid);
-			if(memcmp(tmpData, data, grid->elementSize)==0){
-				*xMin = AV_MIN(*xMin, u);
-				*yMin = AV_MIN(*yMin, v);
-				*xMax = AV_MAX(*xMax, u);
-				*yMax = AV_MAX(*yMax, v);
+	byte* buffer = grid->layout == AV_GRID_LAYOUT_LINEAR ? nullptr : avAllocate(grid->width * grid->elementSize, "allocating grid row buffer");
+	bool32 found = findMinRectRows(matcher, buffer, xMin, yMin, xMax, yMax, grid);
+	if (buffer) {
+		avFree(buffer);
+	}
+	return found;
+}
+
+void avGridFindMinRectSurrounding(void* data, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid) {
+	CellMatcher matcher = {
+		.pattern = data,
+		.elementSize = grid->elementSize,
+	};
+	findMinRect(&matcher, xMin, yMin, xMax, yMax, grid);
+}
+
+bool32 avGridFindMinRectMatching(AvGridCellPredicate predicate, void* userData, uint32* xMin, uint32* yMin, uint32* xMax, uint32* yMax, AvGrid grid) {
+	avAssert(predicate != nullptr, "predicate must be a valid function");
+	CellMatcher matcher = {
+		.elementSize = grid->elementSize,
+		.predicate = predicate,
+		.userData = userData,
+	};
+	return findMinRect(&matcher, xMin, yMin, xMax, yMax, grid);
+}
+
+uint32 avGridScanRows(uint32 yStart, uint32 yEnd, AvGridRowCallback callback, void* userData, AvGrid grid) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	yEnd = AV_MIN(yEnd, grid->height);
+	byte* buffer = grid->layout == AV_GRID_LAYOUT_LINEAR ? nullptr : avAllocate(grid->width * grid->elementSize, "allocating grid row buffer");
+	uint32 visited = 0;
+	for (uint32 y = yStart; y < yEnd; y++) {
+		visited++;
+		if (!callback(getRow(0, y, grid->width, buffer, grid), grid->width, y, userData)) {
+			break;
+		}
+	}
+	if (buffer) {
+		avFree(buffer);
+	}
+	return visited;
+}
+
+bool32 avGridGetTile(uint32 tileX, uint32 tileY, AvGridTile* tile, AvGrid grid) {
+	avAssert(tile != nullptr, "tile must be a valid pointer");
+	uint32 x = tileX * AV_GRID_TILE_SIZE;
+	uint32 y = tileY * AV_GRID_TILE_SIZE;
+	if (tileX >= avGridGetTileCountX(grid) || tileY >= avGridGetTileCountY(grid)) {
+		return false;
+	}
+	tile->x = x;
+	tile->y = y;
+	tile->width = AV_MIN(AV_GRID_TILE_SIZE, grid->width - x);
+	tile->height = AV_MIN(AV_GRID_TILE_SIZE, grid->height - y);
+	tile->elementSize = grid->elementSize;
+	tile->layout = grid->layout;
+	tile->data = getPtr(x, y, grid);
+	switch (grid->layout) {
+	case AV_GRID_LAYOUT_LINEAR:
+		tile->rowStride = grid->width * grid->elementSize;
+		break;
+	case AV_GRID_LAYOUT_TILED:
+		tile->rowStride = AV_GRID_TILE_SIZE * grid->elementSize;
+		break;
+	case AV_GRID_LAYOUT_MORTON:
+		tile->rowStride = 0;
+		break;
+	}
+	return true;
+}
+
+uint32 avGridGetTileCountX(AvGrid grid) {
+	return (grid->width + TILE_MASK) >> TILE_BITS;
+}
+
+uint32 avGridGetTileCountY(AvGrid grid) {
+	return (grid->height + TILE_MASK) >> TILE_BITS;
+}
+
+uint32 avGridForEachTile(AvGridTileCallback callback, void* userData, AvGrid grid) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	uint32 tilesX = avGridGetTileCountX(grid);
+	uint32 tilesY = avGridGetTileCountY(grid);
+	uint32 visited = 0;
+	AvGridTile tile;
+	// visits tiles in storage order so tiled grids are walked front to back
+	for (uint32 tileY = 0; tileY < tilesY; tileY++) {
+		for (uint32 tileX = 0; tileX < tilesX; tileX++) {
+			avGridGetTile(tileX, tileY, &tile, grid);
+			visited++;
+			if (!callback(&tile, userData)) {
+				return visited;
 			}
 		}
 	}
-	avFree(tmpData);
-}
\ No newline at end of file
+	return visited;
+}
+
+void* avGridTileGetPtr(uint32 x, uint32 y, const AvGridTile* tile) {
+	if (x >= tile->width || y >= tile->height) {
+		return nullptr;
+	}
+	if (tile->layout == AV_GRID_LAYOUT_MORTON) {
+		return (byte*)tile->data + tile->elementSize * (mortonSpread[x] | (mortonSpread[y] << 1));
+	}
+	return (byte*)tile->data + tile->rowStride * y + tile->elementSize * x;
+}
@@ -0,0 +1,258 @@
+#include <AvUtils/dataStructures/avPriorityQueue.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+
+// four children per node keeps the tree shallow, the children of a node are adjacent so sifting down reads them in one pass
+#define HEAP_ARITY 4
+#define SLOT_FREE ((uint32)-1)
+
+// the heap only moves these small nodes around, element data stays in its slot
+typedef struct HeapNode {
+	uint64 priority;
+	uint32 slot;
+} HeapNode;
+
+typedef struct AvPriorityQueue_T {
+	HeapNode* heap;
+	uint32 count;
+	uint32 capacity;
+
+	byte* data;
+	uint64 elementSize;
+	uint32* slotHeapIndex;
+	uint32* slotGeneration;
+	uint32 slotCount;
+
+	uint32* freeSlots;
+	uint32 freeCount;
+} AvPriorityQueue_T;
+
+#define HANDLE_SLOT(handle) ((uint32)((handle) & 0xFFFFFFFF))
+#define HANDLE_GENERATION(handle) ((uint32)((handle) >> 32))
+
+void avPriorityQueueCreate(uint64 elementSize, uint32 initialCapacity, AvPriorityQueue* queue) {
+	avAssert(queue != nullptr, "queue must be a valid reference");
+	if (initialCapacity == 0) {
+		initialCapacity = 16;
+	}
+	(*queue) = avCallocate(1, sizeof(AvPriorityQueue_T), "allocating priority queue handle");
+	(*queue)->capacity = initialCapacity;
+	(*queue)->elementSize = elementSize;
+	(*queue)->heap = avAllocate(sizeof(HeapNode) * initialCapacity, "allocating priority queue heap");
+	(*queue)->data = avAllocate(elementSize * initialCapacity + 1, "allocating priority queue data");
+	(*queue)->slotHeapIndex = avAllocate(sizeof(uint32) * initialCapacity, "allocating priority queue slots");
+	(*queue)->slotGeneration = avAllocate(sizeof(uint32) * initialCapacity, "allocating priority queue slots");
+	(*queue)->freeSlots = avAllocate(sizeof(uint32) * initialCapacity, "allocating priority queue slots");
+}
+
+void avPriorityQueueDestroy(AvPriorityQueue queue) {
+	avFree(queue->heap);
+	avFree(queue->data);
+	avFree(queue->slotHeapIndex);
+	avFree(queue->slotGeneration);
+	avFree(queue->freeSlots);
+	avFree(queue);
+}
+
+static void grow(AvPriorityQueue queue) {
+	queue->capacity *= 2;
+	queue->heap = avReallocate(queue->heap, sizeof(HeapNode) * queue->capacity, "resizing priority queue heap");
+	queue->data = avReallocate(queue->data, queue->elementSize * queue->capacity + 1, "resizing priority queue data");
+	queue->slotHeapIndex = avReallocate(queue->slotHeapIndex, sizeof(uint32) * queue->capacity, "resizing priority queue slots");
+	queue->slotGeneration = avReallocate(queue->slotGeneration, sizeof(uint32) * queue->capacity, "resizing priority queue slots");
+	queue->freeSlots = avReallocate(queue->freeSlots, sizeof(uint32) * queue->capacity, "resizing priority queue slots");
+}
+
+static inline void placeNode(HeapNode node, uint32 index, AvPriorityQueue queue) {
+	queue->heap[index] = node;
+	queue->slotHeapIndex[node.slot] = index;
+}
+
+// both sift functions move a hole instead of swapping, so every level costs a single node copy
+static void siftUp(uint32 index, AvPriorityQueue queue) {
+	HeapNode node = queue->heap[index];
+	while (index > 0) {
+		uint32 parent = (index - 1) / HEAP_ARITY;
+		if (queue->heap[parent].priority <= node.priority) {
+			break;
+		}
+		placeNode(queue->heap[parent], index, queue);
+		index = parent;
+	}
+	placeNode(node, index, queue);
+}
+
+static void siftDown(uint32 index, AvPriorityQueue queue) {
+	HeapNode node = queue->heap[index];
+	while (true) {
+		uint32 first = index * HEAP_ARITY + 1;
+		if (first >= queue->count) {
+			break;
+		}
+		uint32 last = first + HEAP_ARITY;
+		if (last > queue->count) {
+			last = queue->count;
+		}
+		uint32 best = first;
+		for (uint32 child = first + 1; child < last; child++) {
+			if (queue->heap[child].priority < queue->heap[best].priority) {
+				best = child;
+			}
+		}
+		if (queue->heap[best].priority >= node.priority) {
+			break;
+		}
+		placeNode(queue->heap[best], index, queue);
+		index = best;
+	}
+	placeNode(node, index, queue);
+}
+
+static uint32 resolveHandle(AvPriorityQueueHandle handle, AvPriorityQueue queue) {
+	uint32 slot = HANDLE_SLOT(handle);
+	if (slot >= queue->slotCount) {
+		return SLOT_FREE;
+	}
+	if (queue->slotGeneration[slot] != HANDLE_GENERATION(handle) || queue->slotHeapIndex[slot] == SLOT_FREE) {
+		return SLOT_FREE;
+	}
+	return slot;
+}
+
+// removes the node at index from the heap and releases its slot
+static void removeAt(uint32 index, void* element, uint64* priority, AvPriorityQueue queue) {
+	HeapNode node = queue->heap[index];
+	if (element) {
+		memcpy(element, queue->data + (uint64)node.slot * queue->elementSize, queue->elementSize);
+	}
+	if (priority) {
+		*priority = node.priority;
+	}
+	queue->slotHeapIndex[node.slot] = SLOT_FREE;
+	queue->slotGeneration[node.slot]++;
+	if (queue->slotGeneration[node.slot] == 0) {
+		queue->slotGeneration[node.slot] = 1;
+	}
+	queue->freeSlots[queue->freeCount++] = node.slot;
+
+	queue->count--;
+	if (index == queue->count) {
+		return;
+	}
+	placeNode(queue->heap[queue->count], index, queue);
+	if (index > 0 && queue->heap[index].priority < queue->heap[(index - 1) / HEAP_ARITY].priority) {
+		siftUp(index, queue);
+	} else {
+		siftDown(index, queue);
+	}
+}
+
+AvPriorityQueueHandle avPriorityQueuePush(const void* element, uint64 priority, AvPriorityQueue queue) {
+	if (queue->count == queue->capacity) {
+		grow(queue);
+	}
+	uint32 slot;
+	if (queue->freeCount) {
+		slot = queue->freeSlots[--queue->freeCount];
+	} else {
+		slot = queue->slotCount++;
+		queue->slotGeneration[slot] = 1;
+	}
+	if (element) {
+		memcpy(queue->data + (uint64)slot * queue->elementSize, element, queue->elementSize);
+	}
+	HeapNode node = { .priority = priority, .slot = slot };
+	placeNode(node, queue->count, queue);
+	queue->count++;
+	siftUp(queue->count - 1, queue);
+	return ((uint64)queue->slotGeneration[slot] << 32) | slot;
+}
+
+bool8 avPriorityQueuePop(void* element, uint64* priority, AvPriorityQueue queue) {
+	if (queue->count == 0) {
+		return 0;
+	}
+	removeAt(0, element, priority, queue);
+	return 1;
+}
+
+bool8 avPriorityQueuePeek(void* element, uint64* priority, AvPriorityQueue queue) {
+	if (queue->count == 0) {
+		return 0;
+	}
+	if (element) {
+		memcpy(element, queue->data + (uint64)queue->heap[0].slot * queue->elementSize, queue->elementSize);
+	}
+	if (priority) {
+		*priority = queue->heap[0].priority;
+	}
+	return 1;
+}
+
+bool8 avPriorityQueueUpdate(AvPriorityQueueHandle handle, uint64 priority, AvPriorityQueue queue) {
+	uint32 slot = resolveHandle(handle, queue);
+	if (slot == SLOT_FREE) {
+		return 0;
+	}
+	uint32 index = queue->slotHeapIndex[slot];
+	uint64 oldPriority = queue->heap[index].priority;
+	queue->heap[index].priority = priority;
+	if (priority < oldPriority) {
+		siftUp(index, queue);
+	} else if (priority > oldPriority) {
+		siftDown(index, queue);
+	}
+	return 1;
+}
+
+bool8 avPriorityQueueRemove(AvPriorityQueueHandle handle, void* element, AvPriorityQueue queue) {
+	uint32 slot = resolveHandle(handle, queue);
+	if (slot == SLOT_FREE) {
+		return 0;
+	}
+	removeAt(queue->slotHeapIndex[slot], element, nullptr, queue);
+	return 1;
+}
+
+bool8 avPriorityQueueContains(AvPriorityQueueHandle handle, AvPriorityQueue queue) {
+	return resolveHandle(handle, queue) != SLOT_FREE;
+}
+
+bool8 avPriorityQueueGetPriority(AvPriorityQueueHandle handle, uint64* priority, AvPriorityQueue queue) {
+	uint32 slot = resolveHandle(handle, queue);
+	if (slot == SLOT_FREE) {
+		return 0;
+	}
+	*priority = queue->heap[queue->slotHeapIndex[slot]].priority;
+	return 1;
+}
+
+void* avPriorityQueueGetElementPtr(AvPriorityQueueHandle handle, AvPriorityQueue queue) {
+	uint32 slot = resolveHandle(handle, queue);
+	if (slot == SLOT_FREE) {
+		return nullptr;
+	}
+	return queue->data + (uint64)slot * queue->elementSize;
+}
+
+void avPriorityQueueClear(AvPriorityQueue queue) {
+	for (uint32 i = 0; i < queue->count; i++) {
+		uint32 slot = queue->heap[i].slot;
+		queue->slotHeapIndex[slot] = SLOT_FREE;
+		queue->slotGeneration[slot]++;
+		if (queue->slotGeneration[slot] == 0) {
+			queue->slotGeneration[slot] = 1;
+		}
+		queue->freeSlots[queue->freeCount++] = slot;
+	}
+	queue->count = 0;
+}
+
+uint32 avPriorityQueueGetCount(AvPriorityQueue queue) {
+	return queue->count;
+}
+
+uint64 avPriorityQueueGetElementSize(AvPriorityQueue queue) {
+	return queue->elementSize;
+}
@@ -1,5 +1,6 @@
 #include <AvUtils/dataStructures/avQueue.h>
 #include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
 #include <string.h>
 
 typedef struct AvQueue_T {
@@ -11,6 +12,7 @@ typedef struct AvQueue_T {
 	uint64 head;
 	uint64 length;
 
+	bool8 growable;
 } AvQueue_T;
 
 static void* getPtr(AvQueue queue, uint64 index) {
@@ -18,6 +20,33 @@ static void* getPtr(AvQueue queue, uint64 index) {
 	return queue->data + queue->elementSize * index;
 }
 
+// moves the elements to the start of a new allocation of at least minSize elements
+static void grow(uint64 minSize, AvQueue queue) {
+	uint64 size = queue->size;
+	while (size < minSize) {
+		size *= 2;
+	}
+	if (size == queue->size) {
+		return;
+	}
+	byte* data = avCallocate(size, queue->elementSize, "allocating queue data");
+	uint64 first = AV_MIN(queue->length, queue->size - queue->head);
+	memcpy(data, getPtr(queue, queue->head), first * queue->elementSize);
+	memcpy(data + first * queue->elementSize, queue->data, (queue->length - first) * queue->elementSize);
+	avFree(queue->data);
+	queue->data = data;
+	queue->size = size;
+	queue->head = 0;
+}
+
+// makes room for count more elements, returns how many of them fit
+static uint64 ensureSpace(uint64 count, AvQueue queue) {
+	if (queue->growable && avQueueGetRemainingSpace(queue) < count) {
+		grow(queue->length + count, queue);
+	}
+	return AV_MIN(count, avQueueGetRemainingSpace(queue));
+}
+
 void avQueueCreate(uint64 elementSize, uint64 queueSize, AvQueue* queue) {
 	
 	if (elementSize == 0) {
@@ -33,6 +62,18 @@ void avQueueCreate(uint64 elementSize, uint64 queueSize, AvQueue* queue) {
 	(*queue)->size = queueSize;
 	(*queue)->head = 0;
 	(*queue)->length = 0;
+	(*queue)->growable = 0;
+}
+
+void avQueueCreateGrowable(uint64 elementSize, uint64 initialSize, AvQueue* queue) {
+	if (initialSize == 0) {
+		initialSize = 1;
+	}
+	avQueueCreate(elementSize, nextPow2L(initialSize), queue);
+	if (elementSize == 0) {
+		return;
+	}
+	(*queue)->growable = 1;
 }
 
 void avQueueDestroy(AvQueue queue) {
@@ -57,10 +98,10 @@ bool8 avQueueIsEmpty(AvQueue queue) {
 }
 
 bool8 avQueuePush(void* element, AvQueue queue) {
-	if (avQueueIsFull(queue)) {
+	if (element == NULL) {
 		return 0;
 	}
-	if (element == NULL) {
+	if (ensureSpace(1, queue) == 0) {
 		return 0;
 	}
 
@@ -83,6 +124,87 @@ bool8 avQueuePull(void* element, AvQueue queue) {
 	return 1;
 }
 
+bool8 avQueuePushFront(void* element, AvQueue queue) {
+	if (element == NULL) {
+		return 0;
+	}
+	if (ensureSpace(1, queue) == 0) {
+		return 0;
+	}
+	queue->head = (queue->head + queue->size - 1) % queue->size;
+	memcpy(getPtr(queue, queue->head), element, queue->elementSize);
+	queue->length++;
+	return 1;
+}
+
+bool8 avQueuePullBack(void* element, AvQueue queue) {
+	if (avQueueIsEmpty(queue)) {
+		return 0;
+	}
+	if (element == NULL) {
+		return 0;
+	}
+	memcpy(element, getPtr(queue, queue->head + queue->length - 1), queue->elementSize);
+	queue->length--;
+	return 1;
+}
+
+uint64 avQueuePushBatch(const void* elements, uint64 count, AvQueue queue) {
+	if (elements == NULL) {
+		return 0;
+	}
+	count = ensureSpace(count, queue);
+	if (count == 0) {
+		return 0;
+	}
+	uint64 index = (queue->head + queue->length) % queue->size;
+	uint64 first = AV_MIN(count, queue->size - index);
+	memcpy(queue->data + index * queue->elementSize, elements, first * queue->elementSize);
+	memcpy(queue->data, (const byte*)elements + first * queue->elementSize, (count - first) * queue->elementSize);
+	queue->length += count;
+	return count;
+}
+
+uint64 avQueuePullBatch(void* elements, uint64 count, AvQueue queue) {
+	if (elements == NULL) {
+		return 0;
+	}
+	void* first;
+	void* second;
+	uint64 firstCount;
+	uint64 secondCount;
+	avQueuePeekSpans(&first, &firstCount, &second, &secondCount, queue);
+	firstCount = AV_MIN(firstCount, count);
+	secondCount = AV_MIN(secondCount, count - firstCount);
+	memcpy(elements, first, firstCount * queue->elementSize);
+	if (secondCount) {
+		memcpy((byte*)elements + firstCount * queue->elementSize, second, secondCount * queue->elementSize);
+	}
+	return avQueueDiscard(firstCount + secondCount, queue);
+}
+
+uint64 avQueuePeekSpans(void** first, uint64* firstCount, void** second, uint64* secondCount, AvQueue queue) {
+	uint64 firstLength = AV_MIN(queue->length, queue->size - queue->head);
+	*first = queue->data + queue->head * queue->elementSize;
+	*firstCount = firstLength;
+	*second = firstLength < queue->length ? queue->data : nullptr;
+	*secondCount = queue->length - firstLength;
+	return queue->length;
+}
+
+uint64 avQueueDiscard(uint64 count, AvQueue queue) {
+	count = AV_MIN(count, queue->length);
+	queue->head = (queue->head + count) % queue->size;
+	queue->length -= count;
+	return count;
+}
+
+void avQueueReserve(uint64 count, AvQueue queue) {
+	if (queue->growable) {
+		ensureSpace(count, queue);
+	}
+}
+
 uint64 avQueueGetSize(AvQueue queue) {
 	return queue->size;
 }
@@ -96,13 +218,14 @@ void avQueueClone(AvQueue src, AvQueue* dst){
 	memcpy((*dst)->data, src->data, src->size * src->elementSize);
 	(*dst)->head = src->head;
 	(*dst)->length = src->length;
+	(*dst)->growable = src->growable;
 }
 
 void* avQueueGetTopPtr(AvQueue queue){
 	if(avQueueIsEmpty(queue)){
 		return nullptr;
 	}
-	return getPtr(queue, queue->head + queue->length);
+	return getPtr(queue, queue->head + queue->length - 1);
 }
 
 void* avQueueGetBottomPtr(AvQueue queue) {
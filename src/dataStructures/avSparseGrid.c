@@ -0,0 +1,235 @@
+#include <AvUtils/dataStructures/avSparseGrid.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/avLogging.h>
+#include <AvUtils/util/avHash.h>
+#include <string.h>
+
+#define CHUNK_BITS 6
+#define CHUNK_MASK (AV_SPARSE_GRID_CHUNK_SIZE - 1)
+#define CHUNK_CELLS (AV_SPARSE_GRID_CHUNK_SIZE * AV_SPARSE_GRID_CHUNK_SIZE)
+#define TABLE_INITIAL_CAPACITY 16
+
+// open addressing with linear probing, a slot is empty when its chunk is nullptr
+typedef struct ChunkEntry {
+	uint64 key;
+	byte* chunk;
+} ChunkEntry;
+
+typedef struct AvSparseGrid_T {
+	uint64 elementSize;
+	byte* defaultValue;
+	// a chunk filled with the default value, copied into every new chunk
+	byte* defaultChunk;
+
+	ChunkEntry* entries;
+	uint64 capacity;
+	uint32 chunkCount;
+
+	// last chunk found, neighbouring accesses mostly hit the same chunk
+	uint64 cachedKey;
+	byte* cachedChunk;
+} AvSparseGrid_T;
+
+static uint64 chunkKey(uint32 x, uint32 y) {
+	return ((uint64)(y >> CHUNK_BITS) << 32) | (x >> CHUNK_BITS);
+}
+
+static uint64 cellOffset(uint32 x, uint32 y, AvSparseGrid grid) {
+	return (((uint64)(y & CHUNK_MASK) << CHUNK_BITS) | (x & CHUNK_MASK)) * grid->elementSize;
+}
+
+void avSparseGridCreate(uint64 elementSize, const void* defaultValue, AvSparseGrid* grid) {
+	avAssert(grid != nullptr, "grid must be a valid reference");
+	if (elementSize == 0) {
+		return;
+	}
+	(*grid) = avCallocate(1, sizeof(AvSparseGrid_T), "allocating sparse grid handle");
+	(*grid)->elementSize = elementSize;
+	(*grid)->defaultValue = avCallocate(1, elementSize, "allocating sparse grid default value");
+	if (defaultValue) {
+		memcpy((*grid)->defaultValue, defaultValue, elementSize);
+	}
+	(*grid)->defaultChunk = avAllocate(CHUNK_CELLS * elementSize, "allocating sparse grid default chunk");
+	for (uint32 i = 0; i < CHUNK_CELLS; i++) {
+		memcpy((*grid)->defaultChunk + i * elementSize, (*grid)->defaultValue, elementSize);
+	}
+	(*grid)->capacity = TABLE_INITIAL_CAPACITY;
+	(*grid)->entries = avCallocate(TABLE_INITIAL_CAPACITY, sizeof(ChunkEntry), "allocating sparse grid chunk table");
+}
+
+void avSparseGridDestroy(AvSparseGrid grid) {
+	avSparseGridClear(grid);
+	avFree(grid->entries);
+	avFree(grid->defaultChunk);
+	avFree(grid->defaultValue);
+	avFree(grid);
+}
+
+static byte* findChunk(uint64 key, AvSparseGrid grid) {
+	if (grid->cachedChunk && grid->cachedKey == key) {
+		return grid->cachedChunk;
+	}
+	uint64 mask = grid->capacity - 1;
+	uint64 slot = avHashU64(key) & mask;
+	while (grid->entries[slot].chunk) {
+		if (grid->entries[slot].key == key) {
+			grid->cachedKey = key;
+			grid->cachedChunk = grid->entries[slot].chunk;
+			return grid->entries[slot].chunk;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return nullptr;
+}
+
+static void insertEntry(ChunkEntry* entries, uint64 capacity, uint64 key, byte* chunk) {
+	uint64 mask = capacity - 1;
+	uint64 slot = avHashU64(key) & mask;
+	while (entries[slot].chunk) {
+		slot = (slot + 1) & mask;
+	}
+	entries[slot].key = key;
+	entries[slot].chunk = chunk;
+}
+
+static void growTable(AvSparseGrid grid) {
+	uint64 capacity = grid->capacity * 2;
+	ChunkEntry* entries = avCallocate(capacity, sizeof(ChunkEntry), "resizing sparse grid chunk table");
+	for (uint64 i = 0; i < grid->capacity; i++) {
+		if (grid->entries[i].chunk) {
+			insertEntry(entries, capacity, grid->entries[i].key, grid->entries[i].chunk);
+		}
+	}
+	avFree(grid->entries);
+	grid->entries = entries;
+	grid->capacity = capacity;
+}
+
+static byte* getOrCreateChunk(uint64 key, AvSparseGrid grid) {
+	byte* chunk = findChunk(key, grid);
+	if (chunk) {
+		return chunk;
+	}
+	// keep the load factor at or below one half
+	if ((uint64)(grid->chunkCount + 1) * 2 > grid->capacity) {
+		growTable(grid);
+	}
+	chunk = avAllocate(CHUNK_CELLS * grid->elementSize, "allocating sparse grid chunk");
+	memcpy(chunk, grid->defaultChunk, CHUNK_CELLS * grid->elementSize);
+	insertEntry(grid->entries, grid->capacity, key, chunk);
+	grid->chunkCount++;
+	grid->cachedKey = key;
+	grid->cachedChunk = chunk;
+	return chunk;
+}
+
+void avSparseGridWrite(const void* data, uint32 x, uint32 y, AvSparseGrid grid) {
+	if (data == nullptr) {
+		return;
+	}
+	byte* chunk = getOrCreateChunk(chunkKey(x, y), grid);
+	memcpy(chunk + cellOffset(x, y, grid), data, grid->elementSize);
+}
+
+void avSparseGridRead(void* data, uint32 x, uint32 y, AvSparseGrid grid) {
+	if (data == nullptr) {
+		return;
+	}
+	byte* chunk = findChunk(chunkKey(x, y), grid);
+	if (chunk == nullptr) {
+		memcpy(data, grid->defaultValue, grid->elementSize);
+		return;
+	}
+	memcpy(data, chunk + cellOffset(x, y, grid), grid->elementSize);
+}
+
+void* avSparseGridGetPtr(uint32 x, uint32 y, AvSparseGrid grid) {
+	byte* chunk = findChunk(chunkKey(x, y), grid);
+	if (chunk == nullptr) {
+		return nullptr;
+	}
+	return chunk + cellOffset(x, y, grid);
+}
+
+void* avSparseGridGetWritePtr(uint32 x, uint32 y, AvSparseGrid grid) {
+	return getOrCreateChunk(chunkKey(x, y), grid) + cellOffset(x, y, grid);
+}
+
+bool32 avSparseGridIsAllocated(uint32 x, uint32 y, AvSparseGrid grid) {
+	return findChunk(chunkKey(x, y), grid) != nullptr;
+}
+
+bool32 avSparseGridReleaseChunk(uint32 x, uint32 y, AvSparseGrid grid) {
+	uint64 key = chunkKey(x, y);
+	uint64 mask = grid->capacity - 1;
+	uint64 slot = avHashU64(key) & mask;
+	while (grid->entries[slot].chunk && grid->entries[slot].key != key) {
+		slot = (slot + 1) & mask;
+	}
+	if (grid->entries[slot].chunk == nullptr) {
+		return false;
+	}
+	avFree(grid->entries[slot].chunk);
+	grid->chunkCount--;
+	grid->cachedChunk = nullptr;
+
+	// backward shift deletion keeps probe sequences intact without tombstones
+	uint64 next = (slot + 1) & mask;
+	while (grid->entries[next].chunk) {
+		uint64 home = avHashU64(grid->entries[next].key) & mask;
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			grid->entries[slot] = grid->entries[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	grid->entries[slot].chunk = nullptr;
+	return true;
+}
+
+void avSparseGridClear(AvSparseGrid grid) {
+	for (uint64 i = 0; i < grid->capacity; i++) {
+		if (grid->entries[i].chunk) {
+			avFree(grid->entries[i].chunk);
+			grid->entries[i].chunk = nullptr;
+		}
+	}
+	grid->chunkCount = 0;
+	grid->cachedChunk = nullptr;
+}
+
+uint32 avSparseGridForEachChunk(AvSparseGridChunkCallback callback, void* userData, AvSparseGrid grid) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	uint32 visited = 0;
+	for (uint64 i = 0; i < grid->capacity; i++) {
+		if (grid->entries[i].chunk == nullptr) {
+			continue;
+		}
+		AvSparseGridChunk chunk = {
+			.chunkX = (uint32)(grid->entries[i].key & 0xFFFFFFFF),
+			.chunkY = (uint32)(grid->entries[i].key >> 32),
+			.data = grid->entries[i].chunk,
+			.rowStride = AV_SPARSE_GRID_CHUNK_SIZE * grid->elementSize,
+		};
+		chunk.x = chunk.chunkX << CHUNK_BITS;
+		chunk.y = chunk.chunkY << CHUNK_BITS;
+		visited++;
+		if (!callback(&chunk, userData)) {
+			break;
+		}
+	}
+	return visited;
+}
+
+uint32 avSparseGridGetChunkCount(AvSparseGrid grid) {
+	return grid->chunkCount;
+}
+
+uint64 avSparseGridGetElementSize(AvSparseGrid grid) {
+	return grid->elementSize;
+}
+
+uint64 avSparseGridGetMemoryUsage(AvSparseGrid grid) {
+	return (uint64)(grid->chunkCount + 1) * CHUNK_CELLS * grid->elementSize + grid->capacity * sizeof(ChunkEntry) + sizeof(AvSparseGrid_T);
+}
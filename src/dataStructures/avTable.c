@@ -1,8 +1,36 @@
 #include <AvUtils/dataStructures/avTable.h>
 #include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/util/avHash.h>
+#include <AvUtils/avLogging.h>
 #include <string.h>
 #include <stdarg.h>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AV_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#define TABLE_INITIAL_CAPACITY 16
+
+typedef struct TableHashEntry {
+	uint64 hash;
+	uint32 row;
+	bool32 used;
+} TableHashEntry;
+
+typedef struct TableIndex {
+	AvTableIndexType type;
+	AvTableElementType elementType;
+
+	// sorted index, row numbers ordered by (value, row) so every row has a unique position
+	uint32* order;
+
+	// hash index, one entry per row with linear probing
+	TableHashEntry* entries;
+	uint64 capacity;
+} TableIndex;
+
 typedef struct AvTable_T {
 
 	uint64* columnSizes;
@@ -10,20 +38,33 @@ typedef struct AvTable_T {
 	uint32 columns;
 
 	uint32 rows;
+	uint32 capacity;
 	uint64 rowSize;
 
+	AvTableLayout layout;
 	void* data;
+	byte** columnData;
+
+	// per column index, allocated when the first index is created
+	TableIndex** indexes;
 
 } AvTable_T;
 
 void avTableCreateFromArray(uint32 columns, uint32 rows, AvTable* table, uint64* columnSizes) {
-	if (columns == 0 || rows == 0 || table == nullptr || columnSizes == nullptr) {
+	avTableCreateFromArrayLayout(AV_TABLE_LAYOUT_ROWS, columns, rows, table, columnSizes);
+}
+
+void avTableCreateFromArrayLayout(AvTableLayout layout, uint32 columns, uint32 rows, AvTable* table, uint64* columnSizes) {
+	if (columns == 0 || table == nullptr || columnSizes == nullptr) {
 		return;
 	}
 
 	(*table) = avCallocate(1, sizeof(AvTable_T), "allocating table handle");
+	(*table)->layout = layout;
 	(*table)->columns = columns;
 	(*table)->rows = rows;
+	// tables created without rows are meant to be filled by appending
+	(*table)->capacity = rows ? rows : TABLE_INITIAL_CAPACITY;
 	(*table)->columnSizes = avAllocate(columns * sizeof(uint64), "allocating collumnsizes");
 	(*table)->columnOffsets = avAllocate(columns * sizeof(uint64), "allocating collumn offsets");
 	memcpy((*table)->columnSizes, columnSizes, columns * sizeof(uint64));
@@ -35,20 +76,38 @@ void avTableCreateFromArray(uint32 columns, uint32 rows, AvTable* table, uint64*
 
 	}
 	(*table)->rowSize = rowSize;
-	(*table)->data = avCallocate(1, rows * rowSize, "allocating table data");
+	if (layout == AV_TABLE_LAYOUT_COLUMNS) {
+		(*table)->columnData = avAllocate(columns * sizeof(byte*), "allocating table columns");
+		for (uint i = 0; i < columns; i++) {
+			(*table)->columnData[i] = avCallocate((*table)->capacity, (*table)->columnSizes[i], "allocating table column data");
+		}
+	} else {
+		(*table)->data = avCallocate((*table)->capacity, rowSize, "allocating table data");
+	}
+}
+
+static void createFromArgs(AvTableLayout layout, uint32 columns, uint32 rows, AvTable* table, va_list args) {
+	uint64* sizes = avCallocate(columns, sizeof(uint64), "allocating collumnsizes");
+	for (uint i = 0; i < columns; i++) {
+		sizes[i] = va_arg(args, uint64);
+	}
+	avTableCreateFromArrayLayout(layout, columns, rows, table, sizes);
+	avFree(sizes);
 }
 
 void avTableCreate(uint32 columns, uint32 rows, AvTable* table, ...) {
 	
 	va_list args;
 	va_start(args, table);
-	uint64* sizes = avCallocate(columns, sizeof(uint64), "allocating collumnsizes");
-	for (uint i = 0; i < columns; i++) {
-		sizes[i] = va_arg(args, uint64);
-	}	
+	createFromArgs(AV_TABLE_LAYOUT_ROWS, columns, rows, table, args);
+	va_end(args);
+}
+
+void avTableCreateLayout(AvTableLayout layout, uint32 columns, uint32 rows, AvTable* table, ...) {
+	va_list args;
+	va_start(args, table);
+	createFromArgs(layout, columns, rows, table, args);
 	va_end(args);
-	avTableCreateFromArray(columns, rows, table, sizes);
-	avFree(sizes);
 }
 
 static bool32 checkBounds(uint32 column, uint32 row, AvTable table) {
@@ -59,17 +118,43 @@ static bool32 checkBounds(uint32 column, uint32 row, AvTable table) {
 }
 
 static void* getPtr(uint32 column, uint32 row, AvTable table) {
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		return table->columnData[column] + (uint64)row * table->columnSizes[column];
+	}
 	uint64 rowOffset = (uint64)row * table->rowSize;
 	uint64 columnOffset = table->columnOffsets[column];
 
 	return (byte*)table->data + rowOffset + columnOffset;
 }
 
+static TableIndex* getIndex(uint32 column, AvTable table) {
+	return table->indexes ? table->indexes[column] : nullptr;
+}
+
+static void indexRemoveRow(TableIndex* index, uint32 column, uint32 row, AvTable table);
+static void indexInsertRow(TableIndex* index, uint32 column, uint32 row, AvTable table);
+static void indexRebuild(TableIndex* index, uint32 column, AvTable table);
+
+static void writeCell(const void* data, uint32 column, uint32 row, AvTable table) {
+	TableIndex* index = getIndex(column, table);
+	void* cell = getPtr(column, row, table);
+	if (index == nullptr) {
+		memcpy(cell, data, table->columnSizes[column]);
+		return;
+	}
+	if (memcmp(cell, data, table->columnSizes[column]) == 0) {
+		return;
+	}
+	indexRemoveRow(index, column, row, table);
+	memcpy(cell, data, table->columnSizes[column]);
+	indexInsertRow(index, column, row, table);
+}
+
 void avTableWrite(void* data, uint32 column, uint32 row, AvTable table) {
 	if (!checkBounds(column, row, table)) {
 		return;
 	}
-	memcpy(getPtr(column, row, table), data, table->columnSizes[column]);
+	writeCell(data, column, row, table);
 }
 
 void avTableRead(void* data, uint32 column, uint32 row, AvTable table) {
@@ -99,6 +184,12 @@ void avTableWriteRow(void* data, uint32 row, AvTable table) {
 	if (!checkBounds(0, row, table)) {
 		return;
 	}
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS || table->indexes) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			writeCell((byte*)data + table->columnOffsets[i], i, row, table);
+		}
+		return;
+	}
 	memcpy(getPtr(0, row, table), data, table->rowSize);
 }
 
@@ -108,9 +199,17 @@ void avTableWriteColumn(void* data, uint32 column, AvTable table) {
 	}
 
 	uint64 columnSize = table->columnSizes[column];
-	uint64 offset = 0;
-	for (uint32 i = 0; i < table->rows; i++) {
-		memcpy(getPtr(column, i, table), (byte*)data + offset, columnSize);
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		memcpy(table->columnData[column], data, columnSize * table->rows);
+	} else {
+		uint64 offset = 0;
+		for (uint32 i = 0; i < table->rows; i++) {
+			memcpy(getPtr(column, i, table), (byte*)data + offset, columnSize);
+			offset += columnSize;
+		}
+	}
+	if (getIndex(column, table)) {
+		indexRebuild(getIndex(column, table), column, table);
 	}
 }
 
@@ -118,6 +217,12 @@ void avTableReadRow(void* data, uint32 row, AvTable table) {
 	if (!checkBounds(0, row, table)) {
 		return;
 	}
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			memcpy((byte*)data + table->columnOffsets[i], getPtr(i, row, table), table->columnSizes[i]);
+		}
+		return;
+	}
 	memcpy(data, getPtr(0, row, table), table->rowSize);
 }
 
@@ -127,10 +232,781 @@ void avTableReadColumn(void* data, uint32 column, AvTable table) {
 	}
 
 	uint64 columnSize = table->columnSizes[column];
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		memcpy(data, table->columnData[column], columnSize * table->rows);
+		return;
+	}
 	uint64 offset = 0;
 	for (uint32 i = 0; i < table->rows; i++) {
 		memcpy((byte*)data + offset, getPtr(column, i, table), columnSize);
+		offset += columnSize;
+	}
+}
+
+AvTableLayout avTableGetLayout(AvTable table) {
+	return table->layout;
+}
+
+void* avTableGetColumnData(uint32 column, AvTable table) {
+	if (table->layout != AV_TABLE_LAYOUT_COLUMNS || column >= table->columns) {
+		return nullptr;
+	}
+	return table->columnData[column];
+}
+
+// columns are reduced in chunks, the row layout gathers each chunk into a packed buffer first
+#define TABLE_GATHER_CHUNK 512
+
+static uint64 getElementTypeSize(AvTableElementType type) {
+	switch (type) {
+		case AV_TABLE_ELEMENT_TYPE_INT32:
+		case AV_TABLE_ELEMENT_TYPE_UINT32:
+		case AV_TABLE_ELEMENT_TYPE_FLOAT:
+			return 4;
+		case AV_TABLE_ELEMENT_TYPE_INT64:
+		case AV_TABLE_ELEMENT_TYPE_UINT64:
+		case AV_TABLE_ELEMENT_TYPE_DOUBLE:
+			return 8;
+		case AV_TABLE_ELEMENT_TYPE_BYTES:
+			break;
+	}
+	return 0;
+}
+
+// returns count packed cells starting at row, either in place or gathered into buffer
+static const byte* getColumnChunk(uint32 column, uint32 row, uint32 count, byte* buffer, AvTable table) {
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		return getPtr(column, row, table);
+	}
+	uint64 columnSize = table->columnSizes[column];
+	for (uint32 i = 0; i < count; i++) {
+		memcpy(buffer + i * columnSize, getPtr(column, row + i, table), columnSize);
+	}
+	return buffer;
+}
+
+static uint32 getChunkSize(AvTable table) {
+	return table->layout == AV_TABLE_LAYOUT_COLUMNS ? table->rows : TABLE_GATHER_CHUNK;
+}
+
+AV_HOT_KERNEL static void sumInt32(const int32* values, uint64 count, int64* sum) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	__m128i accumulator0 = _mm_setzero_si128();
+	__m128i accumulator1 = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(values + i));
+		__m128i sign = _mm_srai_epi32(x, 31);
+		accumulator0 = _mm_add_epi64(accumulator0, _mm_unpacklo_epi32(x, sign));
+		accumulator1 = _mm_add_epi64(accumulator1, _mm_unpackhi_epi32(x, sign));
+	}
+	int64 lanes[2];
+	_mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(accumulator0, accumulator1));
+	*sum += lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		*sum += values[i];
+	}
+}
+
+AV_HOT_KERNEL static void sumUint32(const uint32* values, uint64 count, uint64* sum) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	__m128i accumulator0 = _mm_setzero_si128();
+	__m128i accumulator1 = _mm_setzero_si128();
+	__m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(values + i));
+		accumulator0 = _mm_add_epi64(accumulator0, _mm_unpacklo_epi32(x, zero));
+		accumulator1 = _mm_add_epi64(accumulator1, _mm_unpackhi_epi32(x, zero));
+	}
+	uint64 lanes[2];
+	_mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(accumulator0, accumulator1));
+	*sum += lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		*sum += values[i];
+	}
+}
+
+// signed and unsigned 64 bit sums only differ in interpretation
+AV_HOT_KERNEL static void sumUint64(const uint64* values, uint64 count, uint64* sum) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	__m128i accumulator0 = _mm_setzero_si128();
+	__m128i accumulator1 = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		accumulator0 = _mm_add_epi64(accumulator0, _mm_loadu_si128((const __m128i*)(values + i)));
+		accumulator1 = _mm_add_epi64(accumulator1, _mm_loadu_si128((const __m128i*)(values + i + 2)));
+	}
+	uint64 lanes[2];
+	_mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(accumulator0, accumulator1));
+	*sum += lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		*sum += values[i];
+	}
+}
+
+// floats are accumulated in double precision, the lanes make the summation order differ from a plain loop
+AV_HOT_KERNEL static void sumFloat(const float* values, uint64 count, double* sum) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	__m128d accumulator0 = _mm_setzero_pd();
+	__m128d accumulator1 = _mm_setzero_pd();
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(values + i);
+		accumulator0 = _mm_add_pd(accumulator0, _mm_cvtps_pd(x));
+		accumulator1 = _mm_add_pd(accumulator1, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(accumulator0, accumulator1));
+	*sum += lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		*sum += values[i];
+	}
+}
+
+AV_HOT_KERNEL static void sumDouble(const double* values, uint64 count, double* sum) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	__m128d accumulator0 = _mm_setzero_pd();
+	__m128d accumulator1 = _mm_setzero_pd();
+	for (; i + 4 <= count; i += 4) {
+		accumulator0 = _mm_add_pd(accumulator0, _mm_loadu_pd(values + i));
+		accumulator1 = _mm_add_pd(accumulator1, _mm_loadu_pd(values + i + 2));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(accumulator0, accumulator1));
+	*sum += lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++) {
+		*sum += values[i];
+	}
+}
+
+bool32 avTableColumnSum(uint32 column, AvTableElementType type, void* sum, AvTable table) {
+	if (column >= table->columns || sum == nullptr) {
+		return false;
+	}
+	if (getElementTypeSize(type) != table->columnSizes[column]) {
+		return false;
+	}
+	int64 signedSum = 0;
+	uint64 unsignedSum = 0;
+	double floatSum = 0;
+	byte buffer[TABLE_GATHER_CHUNK * sizeof(uint64)];
+	uint32 chunkSize = getChunkSize(table);
+	for (uint32 row = 0; row < table->rows; row += chunkSize) {
+		uint32 count = AV_MIN(chunkSize, table->rows - row);
+		const byte* values = getColumnChunk(column, row, count, buffer, table);
+		switch (type) {
+			case AV_TABLE_ELEMENT_TYPE_INT32: sumInt32((const int32*)values, count, &signedSum); break;
+			case AV_TABLE_ELEMENT_TYPE_UINT32: sumUint32((const uint32*)values, count, &unsignedSum); break;
+			case AV_TABLE_ELEMENT_TYPE_INT64:
+			case AV_TABLE_ELEMENT_TYPE_UINT64: sumUint64((const uint64*)values, count, &unsignedSum); break;
+			case AV_TABLE_ELEMENT_TYPE_FLOAT: sumFloat((const float*)values, count, &floatSum); break;
+			case AV_TABLE_ELEMENT_TYPE_DOUBLE: sumDouble((const double*)values, count, &floatSum); break;
+			case AV_TABLE_ELEMENT_TYPE_BYTES: break;
+		}
+	}
+	switch (type) {
+		case AV_TABLE_ELEMENT_TYPE_INT32: *(int64*)sum = signedSum; break;
+		case AV_TABLE_ELEMENT_TYPE_INT64: *(int64*)sum = (int64)unsignedSum; break;
+		case AV_TABLE_ELEMENT_TYPE_UINT32:
+		case AV_TABLE_ELEMENT_TYPE_UINT64: *(uint64*)sum = unsignedSum; break;
+		case AV_TABLE_ELEMENT_TYPE_FLOAT:
+		case AV_TABLE_ELEMENT_TYPE_DOUBLE: *(double*)sum = floatSum; break;
+		case AV_TABLE_ELEMENT_TYPE_BYTES: break;
+	}
+	return true;
+}
+
+// folds count values into min and max, which already hold a value of the column
+#define TABLE_MIN_MAX_SCALAR(type, values, start, count, min, max) \
+	for (uint64 i = (start); i < (count); i++) { \
+		type value = ((const type*)(values))[i]; \
+		if (value < *(type*)(min)) *(type*)(min) = value; \
+		if (value > *(type*)(max)) *(type*)(max) = value; \
+	}
+
+AV_HOT_KERNEL static void minMaxInt32(const int32* values, uint64 count, int32* min, int32* max) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	if (count >= 4) {
+		// sse2 has no 32 bit min/max, select through a compare mask instead
+		__m128i low = _mm_set1_epi32(*min);
+		__m128i high = _mm_set1_epi32(*max);
+		for (; i + 4 <= count; i += 4) {
+			__m128i x = _mm_loadu_si128((const __m128i*)(values + i));
+			__m128i less = _mm_cmplt_epi32(x, low);
+			__m128i greater = _mm_cmpgt_epi32(x, high);
+			low = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, low));
+			high = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, high));
+		}
+		int32 lows[4];
+		int32 highs[4];
+		_mm_storeu_si128((__m128i*)lows, low);
+		_mm_storeu_si128((__m128i*)highs, high);
+		TABLE_MIN_MAX_SCALAR(int32, lows, 0, 4, min, max);
+		TABLE_MIN_MAX_SCALAR(int32, highs, 0, 4, min, max);
+	}
+#endif
+	TABLE_MIN_MAX_SCALAR(int32, values, i, count, min, max);
+}
+
+AV_HOT_KERNEL static void minMaxFloat(const float* values, uint64 count, float* min, float* max) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	if (count >= 4) {
+		__m128 low = _mm_set1_ps(*min);
+		__m128 high = _mm_set1_ps(*max);
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(values + i);
+			low = _mm_min_ps(low, x);
+			high = _mm_max_ps(high, x);
+		}
+		float lows[4];
+		float highs[4];
+		_mm_storeu_ps(lows, low);
+		_mm_storeu_ps(highs, high);
+		TABLE_MIN_MAX_SCALAR(float, lows, 0, 4, min, max);
+		TABLE_MIN_MAX_SCALAR(float, highs, 0, 4, min, max);
+	}
+#endif
+	TABLE_MIN_MAX_SCALAR(float, values, i, count, min, max);
+}
+
+AV_HOT_KERNEL static void minMaxDouble(const double* values, uint64 count, double* min, double* max) {
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	if (count >= 2) {
+		__m128d low = _mm_set1_pd(*min);
+		__m128d high = _mm_set1_pd(*max);
+		for (; i + 2 <= count; i += 2) {
+			__m128d x = _mm_loadu_pd(values + i);
+			low = _mm_min_pd(low, x);
+			high = _mm_max_pd(high, x);
+		}
+		double lows[2];
+		double highs[2];
+		_mm_storeu_pd(lows, low);
+		_mm_storeu_pd(highs, high);
+		TABLE_MIN_MAX_SCALAR(double, lows, 0, 2, min, max);
+		TABLE_MIN_MAX_SCALAR(double, highs, 0, 2, min, max);
+	}
+#endif
+	TABLE_MIN_MAX_SCALAR(double, values, i, count, min, max);
+}
+
+AV_HOT_KERNEL static void minMaxUint32(const uint32* values, uint64 count, uint32* min, uint32* max) {
+	TABLE_MIN_MAX_SCALAR(uint32, values, 0, count, min, max);
+}
+
+AV_HOT_KERNEL static void minMaxInt64(const int64* values, uint64 count, int64* min, int64* max) {
+	TABLE_MIN_MAX_SCALAR(int64, values, 0, count, min, max);
+}
+
+AV_HOT_KERNEL static void minMaxUint64(const uint64* values, uint64 count, uint64* min, uint64* max) {
+	TABLE_MIN_MAX_SCALAR(uint64, values, 0, count, min, max);
+}
+
+bool32 avTableColumnMinMax(uint32 column, AvTableElementType type, void* min, void* max, AvTable table) {
+	if (column >= table->columns || table->rows == 0) {
+		return false;
+	}
+	uint64 elementSize = getElementTypeSize(type);
+	if (elementSize != table->columnSizes[column]) {
+		return false;
 	}
+	uint64 low;
+	uint64 high;
+	memcpy(&low, getPtr(column, 0, table), elementSize);
+	memcpy(&high, getPtr(column, 0, table), elementSize);
+	byte buffer[TABLE_GATHER_CHUNK * sizeof(uint64)];
+	uint32 chunkSize = getChunkSize(table);
+	for (uint32 row = 0; row < table->rows; row += chunkSize) {
+		uint32 count = AV_MIN(chunkSize, table->rows - row);
+		const byte* values = getColumnChunk(column, row, count, buffer, table);
+		switch (type) {
+			case AV_TABLE_ELEMENT_TYPE_INT32: minMaxInt32((const int32*)values, count, (int32*)&low, (int32*)&high); break;
+			case AV_TABLE_ELEMENT_TYPE_UINT32: minMaxUint32((const uint32*)values, count, (uint32*)&low, (uint32*)&high); break;
+			case AV_TABLE_ELEMENT_TYPE_INT64: minMaxInt64((const int64*)values, count, (int64*)&low, (int64*)&high); break;
+			case AV_TABLE_ELEMENT_TYPE_UINT64: minMaxUint64((const uint64*)values, count, &low, &high); break;
+			case AV_TABLE_ELEMENT_TYPE_FLOAT: minMaxFloat((const float*)values, count, (float*)&low, (float*)&high); break;
+			case AV_TABLE_ELEMENT_TYPE_DOUBLE: minMaxDouble((const double*)values, count, (double*)&low, (double*)&high); break;
+			case AV_TABLE_ELEMENT_TYPE_BYTES: break;
+		}
+	}
+	if (min) {
+		memcpy(min, &low, elementSize);
+	}
+	if (max) {
+		memcpy(max, &high, elementSize);
+	}
+	return true;
+}
+
+AV_HOT_KERNEL static uint64 countEqual(const byte* values, uint64 count, const byte* value, uint64 size) {
+	uint64 matches = 0;
+	uint64 i = 0;
+#ifdef AV_TABLE_SSE2
+	if (size == 1 || size == 2 || size == 4 || size == 8) {
+		uint64 pattern = 0;
+		memcpy(&pattern, value, size);
+		__m128i needle;
+		switch (size) {
+			case 1: needle = _mm_set1_epi8((char)pattern); break;
+			case 2: needle = _mm_set1_epi16((short)pattern); break;
+			case 4: needle = _mm_set1_epi32((int)pattern); break;
+			default: needle = _mm_set1_epi64x((long long)pattern); break;
+		}
+		uint64 perVector = 16 / size;
+		for (; i + perVector <= count; i += perVector) {
+			__m128i x = _mm_loadu_si128((const __m128i*)(values + i * size));
+			__m128i equal;
+			switch (size) {
+				case 1:
+					matches += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(x, needle)));
+					break;
+				case 2:
+					matches += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi16(x, needle))) / 2;
+					break;
+				case 4:
+					matches += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, needle))));
+					break;
+				default:
+					// a 64 bit lane matches when both of its 32 bit halves do
+					equal = _mm_cmpeq_epi32(x, needle);
+					equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+					matches += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(equal)));
+					break;
+			}
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		matches += memcmp(values + i * size, value, size) == 0;
+	}
+	return matches;
+}
+
+uint64 avTableColumnCountEqual(uint32 column, const void* value, AvTable table) {
+	if (column >= table->columns || value == nullptr) {
+		return 0;
+	}
+	uint64 columnSize = table->columnSizes[column];
+	uint64 matches = 0;
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		return countEqual(table->columnData[column], table->rows, value, columnSize);
+	}
+	byte buffer[TABLE_GATHER_CHUNK * sizeof(uint64)];
+	uint32 chunkSize = columnSize ? (uint32)(sizeof(buffer) / columnSize) : TABLE_GATHER_CHUNK;
+	if (chunkSize == 0) {
+		// cells wider than the gather buffer are compared in place
+		for (uint32 row = 0; row < table->rows; row++) {
+			matches += countEqual(getPtr(column, row, table), 1, value, columnSize);
+		}
+		return matches;
+	}
+	for (uint32 row = 0; row < table->rows; row += chunkSize) {
+		uint32 count = AV_MIN(chunkSize, table->rows - row);
+		matches += countEqual(getColumnChunk(column, row, count, buffer, table), count, value, columnSize);
+	}
+	return matches;
+}
+
+static int32 compareValues(const void* a, const void* b, uint64 size, AvTableElementType type) {
+#define TABLE_COMPARE(valueType) { \
+		valueType x; valueType y; \
+		memcpy(&x, a, sizeof(valueType)); memcpy(&y, b, sizeof(valueType)); \
+		return (x > y) - (x < y); \
+	}
+	switch (type) {
+		case AV_TABLE_ELEMENT_TYPE_INT32: TABLE_COMPARE(int32);
+		case AV_TABLE_ELEMENT_TYPE_UINT32: TABLE_COMPARE(uint32);
+		case AV_TABLE_ELEMENT_TYPE_INT64: TABLE_COMPARE(int64);
+		case AV_TABLE_ELEMENT_TYPE_UINT64: TABLE_COMPARE(uint64);
+		case AV_TABLE_ELEMENT_TYPE_FLOAT: TABLE_COMPARE(float);
+		case AV_TABLE_ELEMENT_TYPE_DOUBLE: TABLE_COMPARE(double);
+		case AV_TABLE_ELEMENT_TYPE_BYTES: break;
+	}
+#undef TABLE_COMPARE
+	return memcmp(a, b, size);
+}
+
+// orders rows by value and then by row number
+static int32 compareRows(uint32 rowA, uint32 rowB, const TableIndex* index, uint32 column, AvTable table) {
+	int32 result = compareValues(getPtr(column, rowA, table), getPtr(column, rowB, table), table->columnSizes[column], index->elementType);
+	if (result != 0) {
+		return result;
+	}
+	return (rowA > rowB) - (rowA < rowB);
+}
+
+// first position in the order whose value is not less than value
+static uint32 lowerBound(const void* value, const TableIndex* index, uint32 column, AvTable table) {
+	uint32 low = 0;
+	uint32 high = table->rows;
+	while (low < high) {
+		uint32 mid = low + (high - low) / 2;
+		if (compareValues(getPtr(column, index->order[mid], table), value, table->columnSizes[column], index->elementType) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+// first position in the order whose value is greater than value
+static uint32 upperBound(const void* value, const TableIndex* index, uint32 column, AvTable table) {
+	uint32 low = 0;
+	uint32 high = table->rows;
+	while (low < high) {
+		uint32 mid = low + (high - low) / 2;
+		if (compareValues(getPtr(column, index->order[mid], table), value, table->columnSizes[column], index->elementType) <= 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+// position of row within the first count entries of the order, or where it belongs
+static uint32 findRowPosition(uint32 row, uint32 count, const TableIndex* index, uint32 column, AvTable table) {
+	uint32 low = 0;
+	uint32 high = count;
+	while (low < high) {
+		uint32 mid = low + (high - low) / 2;
+		if (compareRows(index->order[mid], row, index, column, table) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+static void sortOrder(TableIndex* index, uint32 column, AvTable table) {
+	uint32 count = table->rows;
+	if (count < 2) {
+		return;
+	}
+	uint32* buffer = avAllocate(sizeof(uint32) * count, "allocating table index sort buffer");
+	uint32* src = index->order;
+	uint32* dst = buffer;
+	for (uint32 width = 1; width < count; width *= 2) {
+		for (uint32 start = 0; start < count; start += 2 * width) {
+			uint32 middle = AV_MIN(start + width, count);
+			uint32 end = AV_MIN(start + 2 * width, count);
+			uint32 a = start;
+			uint32 b = middle;
+			uint32 out = start;
+			while (a < middle && b < end) {
+				dst[out++] = compareRows(src[b], src[a], index, column, table) < 0 ? src[b++] : src[a++];
+			}
+			while (a < middle) {
+				dst[out++] = src[a++];
+			}
+			while (b < end) {
+				dst[out++] = src[b++];
+			}
+		}
+		uint32* swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != index->order) {
+		memcpy(index->order, src, sizeof(uint32) * count);
+	}
+	avFree(buffer);
+}
+
+static uint64 hashCell(uint32 column, uint32 row, AvTable table) {
+	return avHash64(getPtr(column, row, table), table->columnSizes[column], AV_HASH_DEFAULT_SEED);
+}
+
+static void hashInsert(TableIndex* index, uint64 hash, uint32 row) {
+	uint64 mask = index->capacity - 1;
+	uint64 slot = hash & mask;
+	while (index->entries[slot].used) {
+		slot = (slot + 1) & mask;
+	}
+	index->entries[slot].hash = hash;
+	index->entries[slot].row = row;
+	index->entries[slot].used = true;
+}
+
+// backward shift deletion keeps probe sequences intact without tombstones
+static void hashRemove(TableIndex* index, uint64 hash, uint32 row) {
+	uint64 mask = index->capacity - 1;
+	uint64 slot = hash & mask;
+	while (index->entries[slot].used && index->entries[slot].row != row) {
+		slot = (slot + 1) & mask;
+	}
+	if (!index->entries[slot].used) {
+		return;
+	}
+	uint64 next = (slot + 1) & mask;
+	while (index->entries[next].used) {
+		uint64 home = index->entries[next].hash & mask;
+		// the entry may fill the hole if its home does not lie cyclically within (slot, next]
+		if (((next - home) & mask) >= ((next - slot) & mask)) {
+			index->entries[slot] = index->entries[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	index->entries[slot].used = false;
+}
+
+static void indexRebuild(TableIndex* index, uint32 column, AvTable table) {
+	if (index->type == AV_TABLE_INDEX_SORTED) {
+		index->order = avReallocate(index->order, sizeof(uint32) * table->capacity, "allocating table index");
+		for (uint32 i = 0; i < table->rows; i++) {
+			index->order[i] = i;
+		}
+		sortOrder(index, column, table);
+		return;
+	}
+	uint64 capacity = nextPow2L(AV_MAX((uint64)table->rows * 2, TABLE_INITIAL_CAPACITY));
+	if (capacity != index->capacity) {
+		avFree(index->entries);
+		index->entries = avAllocate(sizeof(TableHashEntry) * capacity, "allocating table index");
+		index->capacity = capacity;
+	}
+	memset(index->entries, 0, sizeof(TableHashEntry) * capacity);
+	for (uint32 i = 0; i < table->rows; i++) {
+		hashInsert(index, hashCell(column, i, table), i);
+	}
+}
+
+static void indexRemoveRow(TableIndex* index, uint32 column, uint32 row, AvTable table) {
+	if (index->type == AV_TABLE_INDEX_HASH) {
+		hashRemove(index, hashCell(column, row, table), row);
+		return;
+	}
+	uint32 position = findRowPosition(row, table->rows, index, column, table);
+	memmove(index->order + position, index->order + position + 1, sizeof(uint32) * (table->rows - position - 1));
+}
+
+// the order holds every row but the one being reinserted
+static void indexInsertRow(TableIndex* index, uint32 column, uint32 row, AvTable table) {
+	if (index->type == AV_TABLE_INDEX_HASH) {
+		hashInsert(index, hashCell(column, row, table), row);
+		return;
+	}
+	uint32 position = findRowPosition(row, table->rows - 1, index, column, table);
+	memmove(index->order + position + 1, index->order + position, sizeof(uint32) * (table->rows - position - 1));
+	index->order[position] = row;
+}
+
+void avTableCreateIndex(uint32 column, AvTableIndexType type, AvTableElementType elementType, AvTable table) {
+	if (column >= table->columns) {
+		return;
+	}
+	avTableDestroyIndex(column, table);
+	if (table->indexes == nullptr) {
+		table->indexes = avCallocate(table->columns, sizeof(TableIndex*), "allocating table indexes");
+	}
+	TableIndex* index = avCallocate(1, sizeof(TableIndex), "allocating table index");
+	index->type = type;
+	index->elementType = elementType;
+	indexRebuild(index, column, table);
+	table->indexes[column] = index;
+}
+
+void avTableDestroyIndex(uint32 column, AvTable table) {
+	TableIndex* index = column < table->columns ? getIndex(column, table) : nullptr;
+	if (index == nullptr) {
+		return;
+	}
+	avFree(index->order);
+	avFree(index->entries);
+	avFree(index);
+	table->indexes[column] = nullptr;
+}
+
+bool32 avTableHasIndex(uint32 column, AvTable table) {
+	return column < table->columns && getIndex(column, table) != nullptr;
+}
+
+static uint32 collectOrder(uint32 start, uint32 end, const TableIndex* index, uint32* rows, uint32 maxRows) {
+	if (rows) {
+		uint32 count = AV_MIN(end - start, maxRows);
+		memcpy(rows, index->order + start, sizeof(uint32) * count);
+	}
+	return end - start;
+}
+
+uint32 avTableFindEqual(uint32 column, const void* value, uint32* rows, uint32 maxRows, AvTable table) {
+	if (column >= table->columns || value == nullptr) {
+		return 0;
+	}
+	uint64 columnSize = table->columnSizes[column];
+	TableIndex* index = getIndex(column, table);
+	uint32 matches = 0;
+	if (index && index->type == AV_TABLE_INDEX_HASH) {
+		uint64 hash = avHash64(value, columnSize, AV_HASH_DEFAULT_SEED);
+		uint64 mask = index->capacity - 1;
+		for (uint64 slot = hash & mask; index->entries[slot].used; slot = (slot + 1) & mask) {
+			TableHashEntry* entry = &index->entries[slot];
+			if (entry->hash != hash || memcmp(getPtr(column, entry->row, table), value, columnSize) != 0) {
+				continue;
+			}
+			if (rows && matches < maxRows) {
+				rows[matches] = entry->row;
+			}
+			matches++;
+		}
+		return matches;
+	}
+	if (index) {
+		// values that compare equal may still differ bytewise, such as -0.0 and 0.0
+		uint32 end = upperBound(value, index, column, table);
+		for (uint32 i = lowerBound(value, index, column, table); i < end; i++) {
+			if (memcmp(getPtr(column, index->order[i], table), value, columnSize) != 0) {
+				continue;
+			}
+			if (rows && matches < maxRows) {
+				rows[matches] = index->order[i];
+			}
+			matches++;
+		}
+		return matches;
+	}
+	for (uint32 row = 0; row < table->rows; row++) {
+		if (memcmp(getPtr(column, row, table), value, columnSize) != 0) {
+			continue;
+		}
+		if (rows && matches < maxRows) {
+			rows[matches] = row;
+		}
+		matches++;
+	}
+	return matches;
+}
+
+uint32 avTableFindRange(uint32 column, const void* low, const void* high, uint32* rows, uint32 maxRows, AvTable table) {
+	if (column >= table->columns || low == nullptr || high == nullptr) {
+		return 0;
+	}
+	TableIndex* index = getIndex(column, table);
+	if (index == nullptr || index->type != AV_TABLE_INDEX_SORTED) {
+		avAssert(false, "range queries require a sorted index on the column");
+		return 0;
+	}
+	uint32 start = lowerBound(low, index, column, table);
+	uint32 end = upperBound(high, index, column, table);
+	if (end <= start) {
+		return 0;
+	}
+	return collectOrder(start, end, index, rows, maxRows);
+}
+
+static void setCapacity(uint32 capacity, AvTable table) {
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			table->columnData[i] = avReallocate(table->columnData[i], (uint64)capacity * table->columnSizes[i], "resizing table column data");
+		}
+	} else {
+		table->data = avReallocate(table->data, (uint64)capacity * table->rowSize, "resizing table data");
+	}
+	table->capacity = capacity;
+	for (uint32 i = 0; table->indexes && i < table->columns; i++) {
+		if (table->indexes[i] && table->indexes[i]->type == AV_TABLE_INDEX_SORTED) {
+			table->indexes[i]->order = avReallocate(table->indexes[i]->order, sizeof(uint32) * capacity, "resizing table index");
+		}
+	}
+}
+
+void avTableReserve(uint32 rows, AvTable table) {
+	if (rows > table->capacity) {
+		setCapacity(rows, table);
+	}
+}
+
+// grows geometrically so appending row by row stays amortized constant time
+static void ensureCapacity(uint32 rows, AvTable table) {
+	if (rows <= table->capacity) {
+		return;
+	}
+	uint64 capacity = AV_MAX((uint64)table->capacity * 2, rows);
+	setCapacity((uint32)AV_MIN(capacity, (uint64)(uint32)-1), table);
+}
+
+// brings the indexes up to date with the rows from first onwards
+static void indexAppendRows(uint32 first, AvTable table) {
+	for (uint32 i = 0; table->indexes && i < table->columns; i++) {
+		TableIndex* index = table->indexes[i];
+		if (index == nullptr) {
+			continue;
+		}
+		uint32 count = table->rows - first;
+		bool32 rebuild = index->type == AV_TABLE_INDEX_HASH ? (uint64)table->rows * 2 > index->capacity : count > first / 16;
+		if (rebuild) {
+			indexRebuild(index, i, table);
+			continue;
+		}
+		uint32 rows = table->rows;
+		for (uint32 row = first; row < rows; row++) {
+			table->rows = row + 1;
+			indexInsertRow(index, i, row, table);
+		}
+	}
+}
+
+uint32 avTableAppendRow(void* data, AvTable table) {
+	uint32 row = table->rows;
+	ensureCapacity(row + 1, table);
+	table->rows++;
+	if (data == nullptr) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			memset(getPtr(i, row, table), 0, table->columnSizes[i]);
+		}
+	} else if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			memcpy(getPtr(i, row, table), (byte*)data + table->columnOffsets[i], table->columnSizes[i]);
+		}
+	} else {
+		memcpy(getPtr(0, row, table), data, table->rowSize);
+	}
+	indexAppendRows(row, table);
+	return row;
+}
+
+uint32 avTableAppendRows(uint32 count, const void* const* columns, AvTable table) {
+	uint32 first = table->rows;
+	ensureCapacity(first + count, table);
+	table->rows += count;
+	for (uint32 i = 0; i < table->columns; i++) {
+		uint64 columnSize = table->columnSizes[i];
+		const byte* src = columns ? columns[i] : nullptr;
+		if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+			if (src) {
+				memcpy(getPtr(i, first, table), src, columnSize * count);
+			} else {
+				memset(getPtr(i, first, table), 0, columnSize * count);
+			}
+			continue;
+		}
+		for (uint32 row = 0; row < count; row++) {
+			if (src) {
+				memcpy(getPtr(i, first + row, table), src + row * columnSize, columnSize);
+			} else {
+				memset(getPtr(i, first + row, table), 0, columnSize);
+			}
+		}
+	}
+	indexAppendRows(first, table);
+	return first;
+}
+
+uint32 avTableGetCapacity(AvTable table) {
+	return table->capacity;
 }
 
 uint32 avTableGetColumns(AvTable table) {
@@ -142,8 +1018,21 @@ uint32 avTableGetRows(AvTable table) {
 }
 
 void avTableDestroy(AvTable table) {
+	if (table->indexes) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			avTableDestroyIndex(i, table);
+		}
+		avFree(table->indexes);
+	}
+	if (table->layout == AV_TABLE_LAYOUT_COLUMNS) {
+		for (uint32 i = 0; i < table->columns; i++) {
+			avFree(table->columnData[i]);
+		}
+		avFree(table->columnData);
+	} else {
+		avFree(table->data);
+	}
 	avFree(table->columnOffsets);
 	avFree(table->columnSizes);
-	avFree(table->data);
 	avFree(table);
 }
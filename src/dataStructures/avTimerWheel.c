@@ -0,0 +1,343 @@
+#include <AvUtils/dataStructures/avTimerWheel.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avLogging.h>
+#include <AvUtils/avMath.h>
+#include <string.h>
+
+#define SLOT_COUNT (1ULL << AV_TIMER_WHEEL_LEVEL_BITS)
+#define SLOT_MASK (SLOT_COUNT - 1)
+#define WHEEL_BITS (AV_TIMER_WHEEL_LEVEL_BITS * AV_TIMER_WHEEL_LEVEL_COUNT)
+
+// list indices, one per slot followed by the special lists
+#define LIST_OVERFLOW (AV_TIMER_WHEEL_LEVEL_COUNT * SLOT_COUNT)
+#define LIST_DUE (LIST_OVERFLOW + 1)
+#define LIST_FIRING (LIST_OVERFLOW + 2)
+#define LIST_COUNT (LIST_OVERFLOW + 3)
+#define LIST_NONE ((uint32)-1)
+#define NODE_NONE ((uint32)-1)
+
+#define INITIAL_NODE_CAPACITY 64
+
+typedef struct TimerNode {
+	uint64 expiry;
+	uint32 next;
+	uint32 prev;
+	uint32 list;
+	uint32 generation;
+} TimerNode;
+
+// tick is the next tick that has not been processed yet.
+// a timer on level l shares every digit above l with tick, so its slot only has to be
+// cascaded to the lower levels once tick reaches the start of that slot
+typedef struct AvTimerWheel_T {
+	uint64 tick;
+	uint32 count;
+
+	uint32 heads[LIST_COUNT];
+	uint64 occupied[AV_TIMER_WHEEL_LEVEL_COUNT];
+	// lower bound of the overflow list, it is redistributed once tick reaches the wheel revolution of this expiry
+	uint64 overflowMinimum;
+
+	byte* nodes;
+	uint64 nodeStride;
+	uint32 nodeCapacity;
+	uint32 nodeCount;
+	uint32 freeNodes;
+
+	uint64 dataSize;
+	byte* scratch;
+} AvTimerWheel_T;
+
+#define HANDLE_NODE(handle) ((uint32)((handle) & 0xFFFFFFFF))
+#define HANDLE_GENERATION(handle) ((uint32)((handle) >> 32))
+
+static inline TimerNode* getNode(uint32 index, AvTimerWheel wheel) {
+	return (TimerNode*)(wheel->nodes + (uint64)index * wheel->nodeStride);
+}
+
+static inline void* getNodeData(TimerNode* node) {
+	return (byte*)node + sizeof(TimerNode);
+}
+
+void avTimerWheelCreate(uint64 dataSize, uint64 startTick, AvTimerWheel* wheel) {
+	avAssert(wheel != nullptr, "wheel must be a valid reference");
+	(*wheel) = avCallocate(1, sizeof(AvTimerWheel_T), "allocating timer wheel handle");
+	(*wheel)->tick = startTick + 1;
+	for (uint32 i = 0; i < LIST_COUNT; i++) {
+		(*wheel)->heads[i] = NODE_NONE;
+	}
+	(*wheel)->dataSize = dataSize;
+	(*wheel)->nodeStride = (sizeof(TimerNode) + dataSize + 7) & ~7ULL;
+	(*wheel)->nodeCapacity = INITIAL_NODE_CAPACITY;
+	(*wheel)->nodes = avAllocate((*wheel)->nodeStride * INITIAL_NODE_CAPACITY, "allocating timer wheel nodes");
+	(*wheel)->freeNodes = NODE_NONE;
+	(*wheel)->scratch = avAllocate(dataSize + 1, "allocating timer wheel scratch");
+}
+
+void avTimerWheelDestroy(AvTimerWheel wheel) {
+	avFree(wheel->nodes);
+	avFree(wheel->scratch);
+	avFree(wheel);
+}
+
+static void link(uint32 index, uint32 list, AvTimerWheel wheel) {
+	TimerNode* node = getNode(index, wheel);
+	node->list = list;
+	node->prev = NODE_NONE;
+	node->next = wheel->heads[list];
+	if (node->next != NODE_NONE) {
+		getNode(node->next, wheel)->prev = index;
+	}
+	wheel->heads[list] = index;
+	if (list < LIST_OVERFLOW) {
+		wheel->occupied[list / SLOT_COUNT] |= 1ULL << (list & SLOT_MASK);
+	} else if (list == LIST_OVERFLOW && (node->next == NODE_NONE || node->expiry < wheel->overflowMinimum)) {
+		wheel->overflowMinimum = node->expiry;
+	}
+}
+
+static void unlink(uint32 index, AvTimerWheel wheel) {
+	TimerNode* node = getNode(index, wheel);
+	if (node->prev != NODE_NONE) {
+		getNode(node->prev, wheel)->next = node->next;
+	} else {
+		wheel->heads[node->list] = node->next;
+	}
+	if (node->next != NODE_NONE) {
+		getNode(node->next, wheel)->prev = node->prev;
+	}
+	if (node->list < LIST_OVERFLOW && wheel->heads[node->list] == NODE_NONE) {
+		wheel->occupied[node->list / SLOT_COUNT] &= ~(1ULL << (node->list & SLOT_MASK));
+	}
+	node->list = LIST_NONE;
+}
+
+// moves a whole list to another list, returns the previous head of the source
+static uint32 detach(uint32 list, AvTimerWheel wheel) {
+	uint32 head = wheel->heads[list];
+	wheel->heads[list] = NODE_NONE;
+	if (list < LIST_OVERFLOW) {
+		wheel->occupied[list / SLOT_COUNT] &= ~(1ULL << (list & SLOT_MASK));
+	}
+	return head;
+}
+
+static uint32 getList(uint64 expiry, AvTimerWheel wheel) {
+	if (expiry < wheel->tick) {
+		return LIST_DUE;
+	}
+	uint64 diff = expiry ^ wheel->tick;
+	uint32 level = diff == 0 ? 0 : (63 - __builtin_clzll(diff)) / AV_TIMER_WHEEL_LEVEL_BITS;
+	if (level >= AV_TIMER_WHEEL_LEVEL_COUNT) {
+		return LIST_OVERFLOW;
+	}
+	return level * SLOT_COUNT + ((expiry >> (level * AV_TIMER_WHEEL_LEVEL_BITS)) & SLOT_MASK);
+}
+
+static uint32 allocateNode(AvTimerWheel wheel) {
+	if (wheel->freeNodes != NODE_NONE) {
+		uint32 index = wheel->freeNodes;
+		wheel->freeNodes = getNode(index, wheel)->next;
+		return index;
+	}
+	if (wheel->nodeCount == wheel->nodeCapacity) {
+		wheel->nodeCapacity *= 2;
+		wheel->nodes = avReallocate(wheel->nodes, wheel->nodeStride * wheel->nodeCapacity, "resizing timer wheel nodes");
+	}
+	uint32 index = wheel->nodeCount++;
+	getNode(index, wheel)->generation = 1;
+	return index;
+}
+
+static void freeNode(uint32 index, AvTimerWheel wheel) {
+	TimerNode* node = getNode(index, wheel);
+	node->generation++;
+	if (node->generation == 0) {
+		node->generation = 1;
+	}
+	node->list = LIST_NONE;
+	node->next = wheel->freeNodes;
+	wheel->freeNodes = index;
+	wheel->count--;
+}
+
+AvTimerHandle avTimerWheelInsert(uint64 expiry, const void* data, AvTimerWheel wheel) {
+	uint32 index = allocateNode(wheel);
+	TimerNode* node = getNode(index, wheel);
+	node->expiry = expiry;
+	if (data) {
+		memcpy(getNodeData(node), data, wheel->dataSize);
+	}
+	link(index, getList(expiry, wheel), wheel);
+	wheel->count++;
+	return ((uint64)node->generation << 32) | index;
+}
+
+bool8 avTimerWheelCancel(AvTimerHandle handle, AvTimerWheel wheel) {
+	uint32 index = HANDLE_NODE(handle);
+	if (index >= wheel->nodeCount) {
+		return 0;
+	}
+	TimerNode* node = getNode(index, wheel);
+	if (node->generation != HANDLE_GENERATION(handle) || node->list == LIST_NONE) {
+		return 0;
+	}
+	unlink(index, wheel);
+	freeNode(index, wheel);
+	return 1;
+}
+
+// returns the first pending slot of a level together with the tick it has to be handled at
+static uint32 findLevelList(uint32 level, uint64* eventTick, AvTimerWheel wheel) {
+	uint64 tick = wheel->tick;
+	uint32 shift = level * AV_TIMER_WHEEL_LEVEL_BITS;
+	uint64 digit = (tick >> shift) & SLOT_MASK;
+	// the current slot of a higher level only still needs cascading if tick sits exactly on its start
+	bool32 aligned = level == 0 || (tick & ((1ULL << shift) - 1)) == 0;
+	uint64 first = aligned ? digit : digit + 1;
+	if (first >= SLOT_COUNT) {
+		return LIST_NONE;
+	}
+	uint64 bits = wheel->occupied[level] & (~0ULL << first);
+	if (bits == 0) {
+		return LIST_NONE;
+	}
+	uint64 slot = __builtin_ctzll(bits);
+	uint64 blockShift = shift + AV_TIMER_WHEEL_LEVEL_BITS;
+	*eventTick = ((tick >> blockShift) << blockShift) | (slot << shift);
+	return level * SLOT_COUNT + slot;
+}
+
+// finds the list that needs attention first, a level 0 slot fires, any other list gets redistributed.
+// on equal ticks the higher level wins so timers are cascaded before the slot they land in fires
+static uint32 findNextList(uint64* eventTick, AvTimerWheel wheel) {
+	uint32 list = LIST_NONE;
+	if (wheel->heads[LIST_OVERFLOW] != NODE_NONE) {
+		*eventTick = AV_MAX(wheel->tick, (wheel->overflowMinimum >> WHEEL_BITS) << WHEEL_BITS);
+		list = LIST_OVERFLOW;
+	}
+	for (int32 level = AV_TIMER_WHEEL_LEVEL_COUNT - 1; level >= 0; level--) {
+		uint64 levelTick;
+		uint32 levelList = findLevelList(level, &levelTick, wheel);
+		if (levelList != LIST_NONE && (list == LIST_NONE || levelTick < *eventTick)) {
+			*eventTick = levelTick;
+			list = levelList;
+		}
+	}
+	return list;
+}
+
+static void cascade(uint32 list, AvTimerWheel wheel) {
+	uint32 index = detach(list, wheel);
+	while (index != NODE_NONE) {
+		TimerNode* node = getNode(index, wheel);
+		uint32 next = node->next;
+		link(index, getList(node->expiry, wheel), wheel);
+		index = next;
+	}
+}
+
+static uint32 fire(uint32 list, AvTimerWheelCallback callback, void* userData, AvTimerWheel wheel) {
+	// the batch is parked on its own list so callbacks can still cancel timers that have not fired yet
+	uint32 index = detach(list, wheel);
+	wheel->heads[LIST_FIRING] = index;
+	while (index != NODE_NONE) {
+		TimerNode* node = getNode(index, wheel);
+		node->list = LIST_FIRING;
+		index = node->next;
+	}
+	uint32 fired = 0;
+	while (wheel->heads[LIST_FIRING] != NODE_NONE) {
+		index = wheel->heads[LIST_FIRING];
+		TimerNode* node = getNode(index, wheel);
+		uint64 expiry = node->expiry;
+		// the callback may insert timers and move the node storage, so it gets a copy
+		memcpy(wheel->scratch, getNodeData(node), wheel->dataSize);
+		unlink(index, wheel);
+		freeNode(index, wheel);
+		if (callback) {
+			callback(wheel->scratch, expiry, userData);
+		}
+		fired++;
+	}
+	return fired;
+}
+
+uint32 avTimerWheelAdvance(uint64 now, AvTimerWheelCallback callback, void* userData, AvTimerWheel wheel) {
+	if (now < wheel->tick - 1) {
+		return 0;
+	}
+	uint32 fired = 0;
+	if (wheel->heads[LIST_DUE] != NODE_NONE) {
+		fired += fire(LIST_DUE, callback, userData, wheel);
+	}
+	while (true) {
+		uint64 eventTick = 0;
+		uint32 list = findNextList(&eventTick, wheel);
+		if (list == LIST_NONE || eventTick > now) {
+			break;
+		}
+		wheel->tick = eventTick;
+		if (list >= SLOT_COUNT) {
+			cascade(list, wheel);
+			continue;
+		}
+		// timers the callbacks add for this tick land on the due list and fire on the next advance
+		wheel->tick++;
+		fired += fire(list, callback, userData, wheel);
+	}
+	wheel->tick = now + 1;
+	return fired;
+}
+
+static bool8 getListMinimum(uint32 list, uint64* expiry, AvTimerWheel wheel) {
+	uint32 index = wheel->heads[list];
+	if (index == NODE_NONE) {
+		return 0;
+	}
+	uint64 minimum = (uint64)-1;
+	while (index != NODE_NONE) {
+		TimerNode* node = getNode(index, wheel);
+		if (node->expiry < minimum) {
+			minimum = node->expiry;
+		}
+		index = node->next;
+	}
+	*expiry = minimum;
+	return 1;
+}
+
+bool8 avTimerWheelGetNextExpiry(uint64* expiry, AvTimerWheel wheel) {
+	// slots within a level are ordered, so only the first pending slot of every level can hold the earliest timer
+	bool8 found = 0;
+	uint64 minimum = (uint64)-1;
+	uint64 listMinimum;
+	uint64 eventTick;
+	for (uint32 level = 0; level < AV_TIMER_WHEEL_LEVEL_COUNT; level++) {
+		uint32 list = findLevelList(level, &eventTick, wheel);
+		if (list != LIST_NONE && getListMinimum(list, &listMinimum, wheel)) {
+			minimum = AV_MIN(minimum, listMinimum);
+			found = 1;
+		}
+	}
+	if (getListMinimum(LIST_DUE, &listMinimum, wheel)) {
+		minimum = AV_MIN(minimum, listMinimum);
+		found = 1;
+	}
+	if (getListMinimum(LIST_OVERFLOW, &listMinimum, wheel)) {
+		minimum = AV_MIN(minimum, listMinimum);
+		found = 1;
+	}
+	if (found) {
+		*expiry = minimum;
+	}
+	return found;
+}
+
+uint64 avTimerWheelGetTime(AvTimerWheel wheel) {
+	return wheel->tick - 1;
+}
+
+uint32 avTimerWheelGetCount(AvTimerWheel wheel) {
+	return wheel->count;
+}
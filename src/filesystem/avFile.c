@@ -27,7 +27,7 @@ typedef struct AvFile_T {
 	AvFileStatus status;
 	FILE* filehandle;
 	bool32 statted;
-	struct stat* stats;
+	struct stat stats;
 #ifdef _WIN32
 #define getFileDescriptor _fileno
 #else
@@ -87,7 +87,6 @@ AvFile avFileHandleCreate(AvString filePath) {
 	file = avCallocate(1, sizeof(AvFile_T), "allocating file handle");
 	avMemset(file, 0, sizeof(AvFile_T));
 	file->status = AV_FILE_STATUS_CLOSED;
-	file->stats = avCallocate(1, sizeof(struct stat), "allocating file stat");
 	AvString filePathStr = filePath;
 
 	AvFileNameProperties* nameProperties = &file->nameProperties;
@@ -124,10 +123,10 @@ AvFileNameProperties* avFileHandleGetFileNameProperties(AvFile file) {
 #define statProp(prop) (offsetof(struct stat, prop))
 static void* getFileStat(AvFile file, uint64 offset) {
 	if (!file->statted) {
-		stat(file->nameProperties.fileFullPath.chrs, file->stats);
+		stat(file->nameProperties.fileFullPath.chrs, &file->stats);
 		file->statted = true;
 	}
-	return (void*)(((byte*)file->stats) + offset);
+	return (void*)(((byte*)&file->stats) + offset);
 }
 
 
@@ -279,7 +278,6 @@ void avFileHandleDestroy(AvFile file) {
 	if (file->status > AV_FILE_STATUS_CLOSED) {
 		avFileClose(file);
 	}
-	avFree(file->stats);
 	avStringFree(&file->nameProperties.fileNameWithoutExtension);
 	avStringFree(&file->nameProperties.fileExtension);
 	avStringFree(&file->nameProperties.fileName);
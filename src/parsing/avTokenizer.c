@@ -86,7 +86,7 @@ RuleState testRangeRule(AvTokenRule rule, AvString str){
 
         char chr = str.chrs[index];
         bool32 validChar = rule.text.len==0;
-        if(avCharIsNewline(chr)){
+        if(avCharHasClass(chr, AV_CHAR_NEWLINE)){
             goto invalidChar;
         }
 
@@ -148,7 +148,7 @@ void avTokenArrayFree(void* token, uint64 size){
 }
 
 
-AvTokenizeResult avTokenizeString(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules){
+static AvTokenizeResult tokenizeString(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules, AvStringInternPool pool){
     avAssert(tokens != nullptr, "tokens must be a valid reference");
     avAssert(rules != nullptr, "rules must be a valid pointer");
     avAssert(ruleCount != 0, "at least one rule must be specified");
@@ -228,7 +228,7 @@ AvTokenizeResult avTokenizeString(AvString str, AvArrayRef tokens, const uint32
         }
         if(validTokenCount == 0){
             if(!(completeCount || partialCount || overrunCount)){
-                if(avCharIsWhiteSpace(c)){
+                if(avCharHasClass(c, AV_CHAR_SPACE)){
                     goto resetToken;
                 }
                 if(index == str.len){
@@ -307,7 +307,11 @@ tokenizingFailed:
                 .character = token.character,
                 .type = token.type,
             };
-            avStringClone(&newToken.text, token.text);
+            if(pool){
+                avStringUnsafeCopy(&newToken.text, avStringIntern(token.text, pool));
+            }else{
+                avStringClone(&newToken.text, token.text);
+            }
             avArrayWrite(&newToken, i, tokens);
         }
     }
@@ -321,4 +325,13 @@ tokenizingFailed:
         .line = line,
         .character = character,
     };
-}
\ No newline at end of file
+}
+
+AvTokenizeResult avTokenizeString(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules){
+    return tokenizeString(str, tokens, ruleCount, rules, nullptr);
+}
+
+AvTokenizeResult avTokenizeStringInterned(AvString str, AvArrayRef tokens, const uint32 ruleCount, const AvTokenRule* const rules, AvStringInternPool pool){
+    avAssert(pool != nullptr, "pool must be a valid handle");
+    return tokenizeString(str, tokens, ruleCount, rules, pool);
+}
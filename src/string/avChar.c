@@ -1,58 +1,70 @@
 #include <AvUtils/string/avChar.h>
 
+#define U (AV_CHAR_UPPERCASE | AV_CHAR_IDENTIFIER)
+#define L (AV_CHAR_LOWERCASE | AV_CHAR_IDENTIFIER)
+#define UH (U | AV_CHAR_HEX)
+#define LH (L | AV_CHAR_HEX)
+#define D (AV_CHAR_DIGIT | AV_CHAR_HEX | AV_CHAR_IDENTIFIER)
+#define S AV_CHAR_SPACE
+#define N (AV_CHAR_SPACE | AV_CHAR_NEWLINE)
+#define I AV_CHAR_IDENTIFIER
+
+const byte avCharClassTable[256] = {
+    ['\t'] = S, ['\n'] = N, ['\f'] = S, ['\r'] = N, [' '] = S,
+    ['0'] = D, D, D, D, D, D, D, D, D, D,
+    ['A'] = UH, UH, UH, UH, UH, UH, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    ['_'] = I,
+    ['a'] = LH, LH, LH, LH, LH, LH, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L,
+};
+
+#undef U
+#undef L
+#undef UH
+#undef LH
+#undef D
+#undef S
+#undef N
+#undef I
+
 bool32 avCharIsWithinRange(char chr, char start, char end) {
     return (chr >= start) && (chr <= end);
 }
 
 bool32 avCharIsAlphanumeric(char chr){
-    return (avCharIsLetter(chr) || avCharIsNumber(chr));
+    return avCharHasClass(chr, AV_CHAR_ALPHANUMERIC);
 }
 
 bool32 avCharIsLetter(char chr) {
-    return avCharIsLowercaseLetter(chr) || avCharIsUppercaseLetter(chr);
+    return avCharHasClass(chr, AV_CHAR_LETTER);
 }
 bool32 avCharIsUppercaseLetter(char chr) {
-    return avCharIsWithinRange(chr, 'A', 'Z');
+    return avCharHasClass(chr, AV_CHAR_UPPERCASE);
 }
 bool32 avCharIsLowercaseLetter(char chr) {
-    return avCharIsWithinRange(chr, 'a', 'z');
+    return avCharHasClass(chr, AV_CHAR_LOWERCASE);
 }
 
 bool32 avCharIsNumber(char chr) {
-    return avCharIsWithinRange(chr, '0', '9');
+    return avCharHasClass(chr, AV_CHAR_DIGIT);
 }
 bool32 avCharIsHexNumber(char chr) {
-    return avCharIsNumber(chr) || avCharIsWithinRange(chr, 'A', 'F') || avCharIsWithinRange(chr, 'a', 'f');
+    return avCharHasClass(chr, AV_CHAR_HEX);
 }
 
+// the case of an ascii letter is bit 0x20
 char avCharToLowercase(char chr) {
-    return avCharIsUppercaseLetter(chr) ? chr + ('a' - 'A') : chr;
+    return avCharHasClass(chr, AV_CHAR_UPPERCASE) ? chr | 0x20 : chr;
 }
 char avCharToUppercase(char chr) {
-    return avCharIsLowercaseLetter(chr) ? chr - ('a' - 'A') : chr;
+    return avCharHasClass(chr, AV_CHAR_LOWERCASE) ? chr & ~0x20 : chr;
 }
 
 bool32 avCharIsWhiteSpace(char chr) {
-    switch (chr) {
-    case ' ':
-    case '\n':
-    case '\r':
-    case '\t':
-    case '\f':
-        return true;
-    default:
-        return false;
-    }
+    return avCharHasClass(chr, AV_CHAR_SPACE);
 }
 
 bool32 avCharIsNewline(char chr) {
-    switch (chr) {
-    case '\n':
-    case '\r':
-        return true;
-    default:
-        return false;
-    }
+    return avCharHasClass(chr, AV_CHAR_NEWLINE);
 }
 
 bool32 avCharEqualsCaseInsensitive(char chrA, char chrB) {
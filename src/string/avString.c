@@ -4,6 +4,7 @@
 #define AV_DYNAMIC_ARRAY_EXPOSE_MEMORY_LAYOUT
 #include <AvUtils/dataStructures/avDynamicArray.h>
 #include <AvUtils/string/avChar.h>
+#include <AvUtils/string/avStringMatcher.h>
 #include <AvUtils/avLogging.h>
 
 #include <string.h>
@@ -11,23 +12,38 @@
 #include <stdarg.h>
 #include <inttypes.h>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AV_STRING_SSE2
+#include <immintrin.h>
+#define STRING_AVX2_KERNEL AV_HOT_KERNEL_TARGET("avx2,popcnt")
+#endif
+
 #define NULL_TERMINATOR_SIZE 1
 
 typedef struct StringDebugContext_T* StringDebugContext;
-#define STRING_DEBUG_INITIAL_CAPACITY 1
+#define STRING_DEBUG_INITIAL_CAPACITY 16
+// tracks the memory allocated while the context is active. memories is kept dense and every memory
+// stores its index in properties.contextAllocationIndex, so adding and removing are O(1)
 typedef struct StringDebugContext_T {
 	StringDebugContext prev;
-	//AvDynamicArray allocatedMemory;
-
 
 	uint32 allocationCount;
 	uint32 allocationCapacity;
-	uint32* memoryIndex;
-	uint32* memoryReference;
 	AvStringMemoryRef* memories;
-	
+
+	uint64 liveBytes;
+	uint32 peakCount;
+	uint64 peakBytes;
+	uint64 totalAllocations;
 } StringDebugContext_T;
-static StringDebugContext debugContext;
+
+#ifdef _MSC_VER
+	__declspec(thread) static StringDebugContext debugContext;
+#elif defined(__GNUC__)
+	static __thread StringDebugContext debugContext;
+#else
+	static _Thread_local StringDebugContext debugContext;
+#endif
 
 uint64 avCStringLength(const char* str) {
 	avAssert(str!=nullptr, "string cannot be null");
@@ -118,6 +134,18 @@ void avStringShift(AvStringRef str, uint64 newOffset) {
 	memcpy((char*)&str->chrs, &newChrs, sizeof(str->chrs));
 }
 
+static uint64 stringMemoryGetReferenceCount(AvStringMemoryRef memory) {
+	return __atomic_load_n(&memory->referenceCount, __ATOMIC_RELAXED);
+}
+
+static void stringMemoryAddReference(AvStringMemoryRef memory) {
+	if (memory->properties.shared) {
+		__atomic_fetch_add(&memory->referenceCount, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	memory->referenceCount++;
+}
+
 void avStringFromMemory(AvStringRef dst, uint64 offset, uint64 length, AvStringMemoryRef memory) {
 	avAssert(memory != 0, "memory must be valid");
 	avAssert(dst != 0, "destination must be a valid reference");
@@ -143,7 +171,7 @@ void avStringFromMemory(AvStringRef dst, uint64 offset, uint64 length, AvStringM
 		.memory = memory
 	};
 
-	memory->referenceCount++;
+	stringMemoryAddReference(memory);
 
 	memcpy(dst, &result, sizeof(AvString));
 }
@@ -158,11 +186,17 @@ void avStringMemoryClone(AvStringMemoryRef* dst, AvStringMemory src) {
 
 static void stringMemoryRemoveReference(AvStringMemoryRef memory) {
 	avAssert(memory != nullptr, "memory must be a valid reference");
-	avAssert(memory->referenceCount > 0, "freeing while no more references should remain");
+	avAssert(stringMemoryGetReferenceCount(memory) > 0, "freeing while no more references should remain");
 
-	memory->referenceCount--;
+	uint64 remaining;
+	if (memory->properties.shared) {
+		// the release makes every write to the characters visible to the thread that frees them
+		remaining = __atomic_sub_fetch(&memory->referenceCount, 1, __ATOMIC_ACQ_REL);
+	} else {
+		remaining = --memory->referenceCount;
+	}
 
-	if (memory->referenceCount == 0) {
+	if (remaining == 0) {
 		avStringMemoryFree(memory);
 	}
 }
@@ -175,7 +209,7 @@ void avStringFree(AvStringRef str) {
 	}
 	//printf("string { chrs = %.*s, len = %lu, memory = %p }\n", str->len, str->chrs, str->len, str->memory);
 	AvStringMemoryRef memory = str->memory;
-	avAssert(memory->referenceCount > 0, "string memory references are corrupt");
+	avAssert(stringMemoryGetReferenceCount(memory) > 0, "string memory references are corrupt");
 
 	stringMemoryRemoveReference(memory);
 	avMemset(str, 0, sizeof(AvString));
@@ -188,115 +222,76 @@ void avStringMemoryHeapAllocate_(uint64 capacity, AvStringHeapMemory* memory, co
 	avStringMemoryAllocate_(capacity, *memory, file, line);
 }
 
+#ifdef AV_STRING_DEBUG_VALIDATE
+// checks the whole context after every change, O(n) so only enabled on request
+static void validateContext(StringDebugContext context) {
+	uint64 bytes = 0;
+	for (uint32 i = 0; i < context->allocationCount; i++) {
+		AvStringMemoryRef memory = context->memories[i];
+		if (memory == nullptr || memory->properties.contextAllocationIndex != i || memory->properties.debugContext != context) {
+			avAssert(false, "Corruption");
+			return;
+		}
+		bytes += memory->capacity;
+	}
+	avAssert(bytes == context->liveBytes, "Corruption");
+}
+#else
+#define validateContext(context)
+#endif
+
 static void addAllocation(AvStringMemoryRef ref){
 	if (!debugContext) return;
 	if (ref==NULL) {
 		avAssert(false, "Corruption");
 		return;
 	}
-	StringDebugContext context = NULL;
-	if(!ref->properties.heapAllocated){
-		context = debugContext;
-	}else if (debugContext->prev) {
-		context = debugContext->prev;
-	}
-	if(context == NULL) return;
-	ref->properties.debugContext = context;
+	// heap and caller provided memories alike belong to the innermost context
+	StringDebugContext context = debugContext;
 
-	if(context->allocationCount >= context->allocationCapacity){
-		uint32 oldCapacity = context->allocationCapacity;
+	if(context->allocationCount == context->allocationCapacity){
 		context->allocationCapacity *= 2;
-		context->memoryIndex = avReallocate(context->memoryIndex, sizeof(uint32)*context->allocationCapacity, "");
-		context->memoryReference = avReallocate(context->memoryReference, sizeof(uint32)*context->allocationCapacity, "");
-		context->memories = avReallocate(context->memories, sizeof(context->memories[0])*context->allocationCapacity, "");
-		for(uint32 i = oldCapacity; i < context->allocationCapacity; i++){
-			context->memoryIndex[i] = i;
-			context->memoryReference[i] = i;
-			context->memories[i] = NULL;
-		}
+		context->memories = avReallocate(context->memories, sizeof(context->memories[0])*context->allocationCapacity, "resizing string debug context");
 	}
 
-	uint32 index = context->allocationCount++;
-	ref->properties.contextAllocationIndex = context->memoryReference[index];
-	context->memories[index] = ref;
-
-	for(uint32 i = 0; i < context->allocationCount; i++){
-		if(context->memories[i]==NULL){
-			avAssert(false, "Corruption");
-			return;
-		}
-	}
-	for(uint32 i = 0; i < context->allocationCapacity; i++){
-		uint32 id = context->memoryReference[i];
-		uint32 index = context->memoryIndex[id];
-		if(index != i){
-			avAssert(false, "Corruption");
-			return;
-		}
-	}
+	ref->properties.debugContext = context;
+	ref->properties.contextAllocationIndex = context->allocationCount;
+	context->memories[context->allocationCount++] = ref;
+
+	context->liveBytes += ref->capacity;
+	context->totalAllocations++;
+	context->peakCount = AV_MAX(context->peakCount, context->allocationCount);
+	context->peakBytes = AV_MAX(context->peakBytes, context->liveBytes);
+	validateContext(context);
 }
 
 static void removeAllocation(AvStringMemoryRef ref){
-	if (!ref->properties.debugContext){
-		//avAssert(false, "Corruption");
-		return;
-	} 
 	if (ref==NULL) {
 		avAssert(false, "Corruption");
 		return;
 	}
-	StringDebugContext context = ref->properties.debugContext;
-
-	if(context->allocationCount==0) {
-		avAssert(false, "corruption");
+	if (!ref->properties.debugContext){
 		return;
 	}
-	uint32 id = ref->properties.contextAllocationIndex;
-	if(id >= context->allocationCapacity) {
-		avAssert(false, "Corruption");
-		return;
-	};
-	uint32 index = context->memoryIndex[id];
-	if(index >= context->allocationCount) {
-		avAssert(false, "Corruption");
-		return;
-	};
-	if(context->memories[index] != ref) {
+	StringDebugContext context = ref->properties.debugContext;
+
+	uint32 index = ref->properties.contextAllocationIndex;
+	if(index >= context->allocationCount || context->memories[index] != ref) {
 		avAssert(false, "Corruption");
 		return;
 	}
 
+	// move the last memory into the freed slot
+	AvStringMemoryRef last = context->memories[--context->allocationCount];
+	context->memories[index] = last;
+	last->properties.contextAllocationIndex = index;
+	context->memories[context->allocationCount] = NULL;
+
 	ref->properties.contextAllocationIndex = -1;
-	uint32 lastIndex = context->allocationCount-1;
-	uint32 lastId = context->memoryReference[lastIndex];
-	AvStringMemoryRef lastRef = context->memories[lastIndex];
-	if(index==lastIndex){
-		context->memories[index]=NULL;
-		context->allocationCount--;
-		return;
-	}
-	context->memoryReference[lastIndex] = id;
-	context->memoryReference[index] = lastId;
-	context->memoryIndex[lastId] = index;
-	context->memoryIndex[id] = lastIndex;
-	context->memories[lastIndex] = NULL;
-	context->memories[index] = lastRef;
-	context->allocationCount--;
-		// avDynamicArrayRemove(ref->properties.contextAllocationIndex, ((StringDebugContext)ref->properties.debugContext)->allocatedMemory);
-		// for (
-		// 	uint32 i = ref->properties.contextAllocationIndex; 
-		// 	i < avDynamicArrayGetSize(((StringDebugContext)ref->properties.debugContext)->allocatedMemory); 
-		// 	i++
-		// ) {
-		// 	AvStringMemoryRef tmp;
-		// 	avDynamicArrayRead(&tmp, i, ((StringDebugContext)ref->properties.debugContext)->allocatedMemory);
-		// 	tmp->properties.contextAllocationIndex--;
-		// 	avDynamicArrayWrite(&tmp, i, ((StringDebugContext)ref->properties.debugContext)->allocatedMemory);
-		// }
-	
+	context->liveBytes -= ref->capacity;
+	validateContext(context);
 }
 
-
 void avStringMemoryAllocate_(uint64 capacity, AvStringMemoryRef memory, const char* file, uint32 line) {
 	avAssert(memory != nullptr, "invalid memory reference");
 	avAssert(memory->data == nullptr, "string memory already allocated");
@@ -305,7 +300,12 @@ void avStringMemoryAllocate_(uint64 capacity, AvStringMemoryRef memory, const ch
 	avAssert(capacity != 0, "capacity must be > 0");
 
 	memory->capacity = capacity;
-	memory->data = avCallocate(capacity + NULL_TERMINATOR_SIZE, 1, "allocating string data");
+	if (capacity <= AV_STRING_INLINE_CAPACITY) {
+		memset(memory->inlineData, 0, sizeof(memory->inlineData));
+		memory->data = memory->inlineData;
+	} else {
+		memory->data = avCallocate(capacity + NULL_TERMINATOR_SIZE, 1, "allocating string data");
+	}
 	memory->referenceCount = 0;
 	memory->properties.allocationLine = line;
 	memory->properties.allocationFile = file;
@@ -374,7 +374,9 @@ void avStringMemoryFree(AvStringMemoryRef memory) {
 #endif
 
 	if (memory->data) {
-		avFree(memory->data);
+		if (memory->data != memory->inlineData) {
+			avFree(memory->data);
+		}
 		memory->data = nullptr;
 		memory->capacity = 0;
 		memory->properties.debugContext = NULL;
@@ -405,6 +407,40 @@ void avStringMemoryStore(AvString str, uint64 offset, uint64 length, AvStringMem
 	memcpy(memory->data + offset, str.chrs, length);
 }
 
+void avStringMemoryMakeShared(AvStringMemoryRef memory) {
+	avAssert(memory != nullptr, "memory must be a valid reference");
+	avAssert(memory->data != nullptr, "memory has not been allocated");
+	if (memory->properties.shared) {
+		return;
+	}
+#ifndef NDEBUG
+	removeAllocation(memory);
+	memory->properties.debugContext = nullptr;
+#endif
+	memory->properties.shared = true;
+}
+
+void avStringShare_(AvStringRef dst, AvString src, const char* file, uint32 line) {
+	avAssert(dst != nullptr, "destination must be a valid reference");
+	if (src.len == 0) {
+		if (dst->memory) {
+			avStringFree(dst);
+		}
+		avStringUnsafeCopy(dst, AV_EMPTY_STRING);
+		return;
+	}
+	if (src.memory == nullptr) {
+		avStringClone_(dst, src, file, line);
+		avStringMemoryMakeShared(dst->memory);
+		return;
+	}
+	avStringMemoryMakeShared(src.memory);
+	if (dst->memory) {
+		avStringFree(dst);
+	}
+	avStringFromMemory(dst, src.chrs - src.memory->data, src.len, src.memory);
+}
+
 void avStringMemoryAllocStore(AvString str, AvStringMemoryRef memory) {
 	avAssert(memory != nullptr, "memory must be a valid reference");
 	avStringMemoryAllocate(str.len, memory);
@@ -418,18 +454,8 @@ void avStringDebugContextStart_() {
 
 	context->allocationCapacity = STRING_DEBUG_INITIAL_CAPACITY;
 	context->allocationCount = 0;
-	context->memories = avAllocate(sizeof(context->memories[0]) * STRING_DEBUG_INITIAL_CAPACITY, "");
-	context->memoryIndex = avAllocate(sizeof(uint32) * STRING_DEBUG_INITIAL_CAPACITY, "");
-	context->memoryReference = avAllocate(sizeof(uint32) * STRING_DEBUG_INITIAL_CAPACITY, "");
-
-	for(uint32 i = 0; i < STRING_DEBUG_INITIAL_CAPACITY; i++){
-		context->memoryIndex[i] = i;
-		context->memoryReference[i] = i;
-		context->memories[i] = NULL;
-	}
+	context->memories = avCallocate(STRING_DEBUG_INITIAL_CAPACITY, sizeof(context->memories[0]), "allocating string debug context");
 
-	// avDynamicArrayCreate(0, sizeof(AvStringMemoryRef), &context->allocatedMemory);
-	// avDynamicArraySetAllowRelocation(true, context->allocatedMemory);
 	debugContext = context;
 
 }
@@ -439,11 +465,9 @@ void avStringDebugContextEnd_() {
 		avStringPrintln(AV_CSTRA("Debug context inbalance"));
 		return;
 	}
-	//uint unfreedMemory = avDynamicArrayGetSize(debugContext->allocatedMemory);
 	uint32 unfreedMemory = debugContext->allocationCount;
 	for (uint i = 0; i < unfreedMemory; i++) {
 		AvStringMemoryRef stringMemory = debugContext->memories[i];
-		//avDynamicArrayRead(&stringMemory, 0, debugContext->allocatedMemory);
 
 		//TODO: better log
 		avStringPrintf(AV_CSTR("allocated string memory containing \"%S\" has not been freed: %u remaining references, allocated at %s:%i\n"), 
@@ -452,10 +476,9 @@ void avStringDebugContextEnd_() {
 			stringMemory->properties.allocationFile,
 			stringMemory->properties.allocationLine
 		);
+		// the context is gone, freeing the memory later must not touch it
+		stringMemory->properties.debugContext = NULL;
 	}
-	//avDynamicArrayDestroy(debugContext->allocatedMemory);
-	avFree(debugContext->memoryIndex);
-	avFree(debugContext->memoryReference);
 	avFree(debugContext->memories);
 
 	StringDebugContext nextContext = debugContext->prev;
@@ -463,96 +486,412 @@ void avStringDebugContextEnd_() {
 	debugContext = nextContext;
 }
 
-strOffset avStringFindLastOccuranceOfChar(AvString str, char chr) {
-	for (uint64 i = str.len; i > 0; i--) {
-		if (str.chrs[i - 1] == chr) {
-			return i - 1;
+bool32 avStringDebugContextGetStats(AvStringDebugStats* stats) {
+	avAssert(stats != nullptr, "stats must be a valid reference");
+	if (debugContext == nullptr) {
+		return false;
+	}
+	stats->liveCount = debugContext->allocationCount;
+	stats->liveBytes = debugContext->liveBytes;
+	stats->peakCount = debugContext->peakCount;
+	stats->peakBytes = debugContext->peakBytes;
+	stats->totalAllocations = debugContext->totalAllocations;
+	return true;
+}
+
+#ifdef AV_STRING_SSE2
+static bool32 cpuHasAvx2() {
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+#endif
+
+// the byte kernels compare a whole block against the character and work on the resulting bit mask
+
+AV_HOT_KERNEL static uint64 countChar(const char* data, uint64 length, char chr) {
+	uint64 count = 0;
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	__m128i needle = _mm_set1_epi8(chr);
+	for (; i + 16 <= length; i += 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+		count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+	}
+#endif
+	for (; i < length; i++) {
+		count += data[i] == chr;
+	}
+	return count;
+}
+
+AV_HOT_KERNEL static uint64 findLastChar(const char* data, uint64 length, char chr) {
+	uint64 end = length;
+#ifdef AV_STRING_SSE2
+	__m128i needle = _mm_set1_epi8(chr);
+	for (; end >= 16; end -= 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + end - 16));
+		uint32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+		if (mask) {
+			return end - 16 + 31 - __builtin_clz(mask);
+		}
+	}
+#endif
+	while (end > 0) {
+		end--;
+		if (data[end] == chr) {
+			return end;
 		}
 	}
 	return AV_STRING_NULL;
 }
 
-strOffset avStringFindFirstOccranceOfChar(AvString str, char chr) {
-	for (uint64 i = 0; i < str.len; i++) {
-		if (str.chrs[i] == chr) {
+AV_HOT_KERNEL static void replaceChar(char* data, uint64 length, char original, char replacement) {
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	__m128i from = _mm_set1_epi8(original);
+	__m128i to = _mm_set1_epi8(replacement);
+	for (; i + 16 <= length; i += 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+		__m128i match = _mm_cmpeq_epi8(block, from);
+		block = _mm_or_si128(_mm_and_si128(match, to), _mm_andnot_si128(match, block));
+		_mm_storeu_si128((__m128i*)(data + i), block);
+	}
+#endif
+	for (; i < length; i++) {
+		if (data[i] == original) {
+			data[i] = replacement;
+		}
+	}
+}
+
+// sets of up to 16 characters are compared one vector per character, larger sets go through a lookup table
+#define CHAR_SET_VECTOR_MAX 16
+
+AV_HOT_KERNEL static uint64 findFirstOfSet(const char* data, uint64 length, const char* set, uint64 setLength) {
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	if (setLength <= CHAR_SET_VECTOR_MAX) {
+		__m128i needles[CHAR_SET_VECTOR_MAX];
+		for (uint64 j = 0; j < setLength; j++) {
+			needles[j] = _mm_set1_epi8(set[j]);
+		}
+		for (; i + 16 <= length; i += 16) {
+			__m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+			__m128i match = _mm_setzero_si128();
+			for (uint64 j = 0; j < setLength; j++) {
+				match = _mm_or_si128(match, _mm_cmpeq_epi8(block, needles[j]));
+			}
+			uint32 mask = _mm_movemask_epi8(match);
+			if (mask) {
+				return i + __builtin_ctz(mask);
+			}
+		}
+	}
+#endif
+	bool8 table[256] = { 0 };
+	for (uint64 j = 0; j < setLength; j++) {
+		table[(byte)set[j]] = true;
+	}
+	for (; i < length; i++) {
+		if (table[(byte)data[i]]) {
 			return i;
 		}
 	}
 	return AV_STRING_NULL;
 }
 
-bool32 avStringContainsChar(AvString str, char chr) {
-	return (avStringFindCharCount(str, chr) != 0);
+AV_HOT_KERNEL static uint64 findLastOfSet(const char* data, uint64 length, const char* set, uint64 setLength) {
+	bool8 table[256] = { 0 };
+	for (uint64 j = 0; j < setLength; j++) {
+		table[(byte)set[j]] = true;
+	}
+	for (uint64 i = length; i > 0; i--) {
+		if (table[(byte)data[i - 1]]) {
+			return i - 1;
+		}
+	}
+	return AV_STRING_NULL;
 }
 
-bool32 avStringContains(AvString str, AvString sequence) {
-	return avStringFindCount(str, sequence) != 0;
+#ifdef AV_STRING_SSE2
+STRING_AVX2_KERNEL static uint64 countCharAvx2(const char* data, uint64 length, char chr) {
+	uint64 count = 0;
+	uint64 i = 0;
+	__m256i needle = _mm256_set1_epi8(chr);
+	for (; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+		count += __builtin_popcount((uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+	}
+	return count + countChar(data + i, length - i, chr);
 }
 
-uint64 avStringFindCharCount(AvString str, char chr) {
-	uint64 count = 0;
-	for (uint64 i = 0; i < str.len; i++) {
-		if (str.chrs[i] == chr) {
-			count++;
+STRING_AVX2_KERNEL static uint64 findLastCharAvx2(const char* data, uint64 length, char chr) {
+	uint64 end = length;
+	__m256i needle = _mm256_set1_epi8(chr);
+	for (; end >= 32; end -= 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + end - 32));
+		uint32 mask = (uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+		if (mask) {
+			return end - 32 + 31 - __builtin_clz(mask);
 		}
 	}
-	return count;
+	return findLastChar(data, end, chr);
 }
 
-strOffset avStringFindLastOccuranceOf(AvString str, AvString find) {
-	if (str.len < find.len) {
+STRING_AVX2_KERNEL static void replaceCharAvx2(char* data, uint64 length, char original, char replacement) {
+	uint64 i = 0;
+	__m256i from = _mm256_set1_epi8(original);
+	__m256i to = _mm256_set1_epi8(replacement);
+	for (; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+		block = _mm256_blendv_epi8(block, to, _mm256_cmpeq_epi8(block, from));
+		_mm256_storeu_si256((__m256i*)(data + i), block);
+	}
+	replaceChar(data + i, length - i, original, replacement);
+}
+
+STRING_AVX2_KERNEL static uint64 findFirstOfSetAvx2(const char* data, uint64 length, const char* set, uint64 setLength) {
+	uint64 i = 0;
+	__m256i needles[CHAR_SET_VECTOR_MAX];
+	for (uint64 j = 0; j < setLength; j++) {
+		needles[j] = _mm256_set1_epi8(set[j]);
+	}
+	for (; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+		__m256i match = _mm256_setzero_si256();
+		for (uint64 j = 0; j < setLength; j++) {
+			match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, needles[j]));
+		}
+		uint32 mask = (uint32)_mm256_movemask_epi8(match);
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+	uint64 offset = findFirstOfSet(data + i, length - i, set, setLength);
+	return offset == AV_STRING_NULL ? AV_STRING_NULL : i + offset;
+}
+#endif
+
+strOffset avStringFindLastOccuranceOfChar(AvString str, char chr) {
+#ifdef AV_STRING_SSE2
+	if (cpuHasAvx2()) {
+		return findLastCharAvx2(str.chrs, str.len, chr);
+	}
+#endif
+	return findLastChar(str.chrs, str.len, chr);
+}
+
+strOffset avStringFindFirstOccranceOfChar(AvString str, char chr) {
+	// memchr is already vectorized by the c library
+	const char* found = str.len ? memchr(str.chrs, chr, str.len) : nullptr;
+	return found ? found - str.chrs : AV_STRING_NULL;
+}
+
+strOffset avStringFindFirstOccuranceOfAny(AvString str, AvString chars) {
+	if (chars.len == 0) {
 		return AV_STRING_NULL;
 	}
+	if (chars.len == 1) {
+		return avStringFindFirstOccranceOfChar(str, chars.chrs[0]);
+	}
+#ifdef AV_STRING_SSE2
+	if (chars.len <= CHAR_SET_VECTOR_MAX && cpuHasAvx2()) {
+		return findFirstOfSetAvx2(str.chrs, str.len, chars.chrs, chars.len);
+	}
+#endif
+	return findFirstOfSet(str.chrs, str.len, chars.chrs, chars.len);
+}
 
-	for (uint64 i = str.len - find.len; i > 0; i--) {
-		uint64 j = 0;
-		for (; j < find.len; j++) {
-			if (str.chrs[i - 1 + j] != find.chrs[j]) {
-				break;
+strOffset avStringFindLastOccuranceOfAny(AvString str, AvString chars) {
+	if (chars.len == 1) {
+		return avStringFindLastOccuranceOfChar(str, chars.chrs[0]);
+	}
+	return findLastOfSet(str.chrs, str.len, chars.chrs, chars.len);
+}
+
+bool32 avStringContainsChar(AvString str, char chr) {
+	return avStringFindFirstOccranceOfChar(str, chr) != AV_STRING_NULL;
+}
+
+bool32 avStringContains(AvString str, AvString sequence) {
+	return avStringFindFirstOccuranceOf(str, sequence) != AV_STRING_NULL;
+}
+
+uint64 avStringFindCharCount(AvString str, char chr) {
+#ifdef AV_STRING_SSE2
+	if (cpuHasAvx2()) {
+		return countCharAvx2(str.chrs, str.len, chr);
+	}
+#endif
+	return countChar(str.chrs, str.len, chr);
+}
+
+// needles up to this length are found by filtering on their first and last character,
+// longer needles use Boyer-Moore-Horspool which skips ahead by up to the needle length
+#define SEARCH_SHORT_NEEDLE 32
+
+static inline bool32 matchesAt(const char* haystack, uint64 offset, const char* needle, uint64 needleLength) {
+	return haystack[offset] == needle[0] && haystack[offset + needleLength - 1] == needle[needleLength - 1]
+		&& memcmp(haystack + offset + 1, needle + 1, needleLength - 2) == 0;
+}
+
+// candidates are the starts where both the first and the last character of the needle match, 16 starts at a time
+AV_HOT_KERNEL static uint64 searchShortForward(const char* haystack, uint64 length, const char* needle, uint64 needleLength) {
+	uint64 starts = length - needleLength + 1;
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	__m128i first = _mm_set1_epi8(needle[0]);
+	__m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+	for (; i + 16 <= starts; i += 16) {
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(haystack + i));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(haystack + i + needleLength - 1));
+		uint32 mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+		while (mask) {
+			uint32 bit = __builtin_ctz(mask);
+			if (memcmp(haystack + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+				return i + bit;
 			}
+			mask &= mask - 1;
+		}
+	}
+#endif
+	while (i < starts) {
+		const char* candidate = memchr(haystack + i, needle[0], starts - i);
+		if (candidate == nullptr) {
+			break;
 		}
-		if (j == find.len) {
+		i = candidate - haystack;
+		if (matchesAt(haystack, i, needle, needleLength)) {
 			return i;
 		}
+		i++;
 	}
 	return AV_STRING_NULL;
 }
 
-strOffset avStringFindFirstOccuranceOf(AvString str, AvString find) {
-	if (str.len < find.len) {
-		return AV_STRING_NULL;
-	}
-	for (uint64 i = 0; i < str.len; i++) {
-		bool32 match = true;
-		for(uint64 j = i; j < AV_MIN(str.len, i+find.len); j++){
-			if(str.chrs[j]!=find.chrs[j-i]){
-				match = false;
-				break;
+AV_HOT_KERNEL static uint64 searchShortBackward(const char* haystack, uint64 length, const char* needle, uint64 needleLength) {
+	uint64 end = length - needleLength + 1;
+#ifdef AV_STRING_SSE2
+	__m128i first = _mm_set1_epi8(needle[0]);
+	__m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+	for (; end >= 16; end -= 16) {
+		uint64 i = end - 16;
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(haystack + i));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(haystack + i + needleLength - 1));
+		uint32 mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+		while (mask) {
+			uint32 bit = 31 - __builtin_clz(mask);
+			if (memcmp(haystack + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+				return i + bit;
 			}
+			mask &= ~(1u << bit);
 		}
-		if(match){
+	}
+#endif
+	while (end > 0) {
+		end--;
+		if (matchesAt(haystack, end, needle, needleLength)) {
+			return end;
+		}
+	}
+	return AV_STRING_NULL;
+}
+
+AV_HOT_KERNEL static uint64 searchHorspoolForward(const char* haystack, uint64 length, const char* needle, uint64 needleLength) {
+	uint64 skip[256];
+	for (uint32 c = 0; c < 256; c++) {
+		skip[c] = needleLength;
+	}
+	for (uint64 j = 0; j < needleLength - 1; j++) {
+		skip[(byte)needle[j]] = needleLength - 1 - j;
+	}
+	char lastChar = needle[needleLength - 1];
+	uint64 i = 0;
+	while (i <= length - needleLength) {
+		char c = haystack[i + needleLength - 1];
+		if (c == lastChar && memcmp(haystack + i, needle, needleLength - 1) == 0) {
 			return i;
 		}
+		i += skip[(byte)c];
 	}
 	return AV_STRING_NULL;
 }
 
+// mirror image of the forward search, the window is aligned on the first character of the needle
+AV_HOT_KERNEL static uint64 searchHorspoolBackward(const char* haystack, uint64 length, const char* needle, uint64 needleLength) {
+	uint64 skip[256];
+	for (uint32 c = 0; c < 256; c++) {
+		skip[c] = needleLength;
+	}
+	for (uint64 j = needleLength - 1; j > 0; j--) {
+		skip[(byte)needle[j]] = j;
+	}
+	char firstChar = needle[0];
+	uint64 i = length - needleLength;
+	while (true) {
+		char c = haystack[i];
+		if (c == firstChar && memcmp(haystack + i + 1, needle + 1, needleLength - 1) == 0) {
+			return i;
+		}
+		if (skip[(byte)c] > i) {
+			return AV_STRING_NULL;
+		}
+		i -= skip[(byte)c];
+	}
+}
+
+// finds the first occurance of needle in haystack at or after start
+static uint64 searchForward(const char* haystack, uint64 length, uint64 start, const char* needle, uint64 needleLength) {
+	if (start > length || needleLength > length - start) {
+		return AV_STRING_NULL;
+	}
+	if (needleLength == 0) {
+		return start;
+	}
+	uint64 offset;
+	if (needleLength == 1) {
+		const char* found = memchr(haystack + start, needle[0], length - start);
+		return found ? (uint64)(found - haystack) : AV_STRING_NULL;
+	} else if (needleLength <= SEARCH_SHORT_NEEDLE) {
+		offset = searchShortForward(haystack + start, length - start, needle, needleLength);
+	} else {
+		offset = searchHorspoolForward(haystack + start, length - start, needle, needleLength);
+	}
+	return offset == AV_STRING_NULL ? AV_STRING_NULL : start + offset;
+}
+
+static uint64 searchBackward(const char* haystack, uint64 length, const char* needle, uint64 needleLength) {
+	if (needleLength > length) {
+		return AV_STRING_NULL;
+	}
+	if (needleLength == 0) {
+		return length;
+	}
+	if (needleLength == 1) {
+		return avStringFindLastOccuranceOfChar(AV_STR(haystack, length), needle[0]);
+	}
+	if (needleLength <= SEARCH_SHORT_NEEDLE) {
+		return searchShortBackward(haystack, length, needle, needleLength);
+	}
+	return searchHorspoolBackward(haystack, length, needle, needleLength);
+}
+
+strOffset avStringFindLastOccuranceOf(AvString str, AvString find) {
+	return searchBackward(str.chrs, str.len, find.chrs, find.len);
+}
+
+strOffset avStringFindFirstOccuranceOf(AvString str, AvString find) {
+	return searchForward(str.chrs, str.len, 0, find.chrs, find.len);
+}
+
 uint64 avStringFindCount(AvString str, AvString find) {
-	uint64 strOffset = 0;
-	if (str.len < find.len) {
+	if (find.len == 0) {
 		return 0;
 	}
 	uint64 count = 0;
-	for (uint64 i = 0; i < str.len; i++) {
-		if (str.chrs[i] == find.chrs[strOffset]) {
-			strOffset++;
-			if (strOffset == find.len) {
-				count++;
-				strOffset = 0;
-			}
-		} else {
-			strOffset = 0;
-		}
+	uint64 offset = searchForward(str.chrs, str.len, 0, find.chrs, find.len);
+	while (offset != AV_STRING_NULL) {
+		count++;
+		offset = searchForward(str.chrs, str.len, offset + find.len, find.chrs, find.len);
 	}
 	return count;
 }
@@ -561,25 +900,14 @@ bool32 avStringEndsWith(AvString str, AvString sequence) {
 	if(str.len < sequence.len){
 		return false;
 	}
-	uint64 offset = str.len - sequence.len;
-	for(uint64 i = offset; i < str.len; i++){
-		if(str.chrs[i] != sequence.chrs[i-offset]){
-			return false;
-		}
-	}
-	return true;
+	return sequence.len == 0 || memcmp(str.chrs + str.len - sequence.len, sequence.chrs, sequence.len) == 0;
 }
 
 bool32 avStringStartsWith(AvString str, AvString sequence) {
 	if(str.len < sequence.len){
 		return false;
 	}
-	for(uint64 i = 0; i < sequence.len; i++){
-		if(str.chrs[i] != sequence.chrs[i]){
-			return false;
-		}
-	}
-	return true;
+	return sequence.len == 0 || memcmp(str.chrs, sequence.chrs, sequence.len) == 0;
 }
 
 bool32 avStringEndsWithChar(AvString str, char chr) {
@@ -621,58 +949,342 @@ char avStringRead(AvString str, strOffset offset) {
 }
 
 
-void avStringToUppercase(AvStringRef str) {
+// flips the case bit of every byte in [first, last], used with the range of one letter case
+AV_HOT_KERNEL static void convertCase(char* data, uint64 length, char first, char last) {
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	__m128i below = _mm_set1_epi8(first - 1);
+	__m128i above = _mm_set1_epi8(last + 1);
+	__m128i caseBit = _mm_set1_epi8(0x20);
+	for (; i + 16 <= length; i += 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+		__m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, below), _mm_cmplt_epi8(block, above));
+		block = _mm_xor_si128(block, _mm_and_si128(inRange, caseBit));
+		_mm_storeu_si128((__m128i*)(data + i), block);
+	}
+#endif
+	for (; i < length; i++) {
+		if (data[i] >= first && data[i] <= last) {
+			data[i] ^= 0x20;
+		}
+	}
+}
+
+#ifdef AV_STRING_SSE2
+STRING_AVX2_KERNEL static void convertCaseAvx2(char* data, uint64 length, char first, char last) {
+	__m256i below = _mm256_set1_epi8(first - 1);
+	__m256i above = _mm256_set1_epi8(last + 1);
+	__m256i caseBit = _mm256_set1_epi8(0x20);
+	uint64 i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+		__m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(block, below), _mm256_cmpgt_epi8(above, block));
+		block = _mm256_xor_si256(block, _mm256_and_si256(inRange, caseBit));
+		_mm256_storeu_si256((__m256i*)(data + i), block);
+	}
+	convertCase(data + i, length - i, first, last);
+}
+#endif
+
+static void stringConvertCase(AvStringRef str, char first, char last) {
 	avAssert(str != nullptr, "string must be a valid reference");
 	if (str->memory == nullptr) {
 		avStringClone(str, *str);
 	}
 	uint64 offset = str->chrs - str->memory->data;
-	for (uint i = offset; i < AV_MIN(str->len + offset, str->memory->capacity); i++) {
-		str->memory->data[i] = avCharToUppercase(str->memory->data[i]);
+	uint64 length = AV_MIN(str->len + offset, str->memory->capacity) - offset;
+	char* data = str->memory->data + offset;
+#ifdef AV_STRING_SSE2
+	if (length >= 64 && cpuHasAvx2()) {
+		convertCaseAvx2(data, length, first, last);
+		return;
 	}
+#endif
+	convertCase(data, length, first, last);
+}
+
+void avStringToUppercase(AvStringRef str) {
+	stringConvertCase(str, 'a', 'z');
 }
 void avStringToLowercase(AvStringRef str) {
-	avAssert(str != nullptr, "string must be a valid reference");
-	if (str->memory == nullptr) {
-		avStringClone(str, *str);
+	stringConvertCase(str, 'A', 'Z');
+}
+
+// spans check the first characters through the class table, longer spans switch to a vector lookup
+#define SPAN_SCALAR_PREFIX 16
+
+AV_HOT_KERNEL static uint64 spanScalar(const char* data, uint64 start, uint64 length, byte classes, bool32 invert) {
+	for (uint64 i = start; i < length; i++) {
+		if (avCharHasClass(data[i], classes) == invert) {
+			return i;
+		}
 	}
-	uint64 offset = str->chrs - str->memory->data;
-	for (uint i = offset; i < AV_MIN(str->len + offset, str->memory->capacity); i++) {
-		str->memory->data[i] = avCharToLowercase(str->memory->data[i]);
+	return length;
+}
+
+#ifdef AV_STRING_SSE2
+// ascii bytes are looked up in two 16 entry tables: the row of the low nibble holds one bit per high nibble
+// of the bytes in the set, the high nibble selects which bit to test. bytes above 0x7f select an empty bit
+typedef struct SpanTables {
+	byte rows[16];
+	byte bits[16];
+} SpanTables;
+
+static void buildSpanTables(byte classes, SpanTables* tables) {
+	memset(tables, 0, sizeof(SpanTables));
+	for (uint32 chr = 0; chr < 128; chr++) {
+		if (avCharClassTable[chr] & classes) {
+			tables->rows[chr & 0x0F] |= 1 << (chr >> 4);
+		}
+	}
+	for (uint32 high = 0; high < 8; high++) {
+		tables->bits[high] = 1 << high;
+	}
+}
+
+STRING_AVX2_KERNEL static uint64 spanAvx2(const char* data, uint64 start, uint64 length, byte classes, bool32 invert) {
+	SpanTables tables;
+	buildSpanTables(classes, &tables);
+	__m256i rows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tables.rows));
+	__m256i bits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tables.bits));
+	__m256i nibble = _mm256_set1_epi8(0x0F);
+	uint32 expected = invert ? 0 : 0xFFFFFFFF;
+	uint64 i = start;
+	for (; i + 32 <= length; i += 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+		__m256i row = _mm256_shuffle_epi8(rows, _mm256_and_si256(block, nibble));
+		__m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+		__m256i member = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+		// bytes above 0x7f select a zero bit, which would otherwise compare as a member
+		member = _mm256_andnot_si256(_mm256_cmpeq_epi8(bit, _mm256_setzero_si256()), member);
+		uint32 mask = (uint32)_mm256_movemask_epi8(member) ^ expected;
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
 	}
+	return spanScalar(data, i, length, classes, invert);
+}
+#endif
+
+static uint64 stringSpan(AvString str, byte classes, bool32 invert) {
+	uint64 prefix = AV_MIN(str.len, SPAN_SCALAR_PREFIX);
+	uint64 span = spanScalar(str.chrs, 0, prefix, classes, invert);
+	if (span < prefix || prefix == str.len) {
+		return span;
+	}
+#ifdef AV_STRING_SSE2
+	if (cpuHasAvx2()) {
+		return spanAvx2(str.chrs, prefix, str.len, classes, invert);
+	}
+#endif
+	return spanScalar(str.chrs, prefix, str.len, classes, invert);
+}
+
+uint64 avStringSpanClass(AvString str, byte classes) {
+	return stringSpan(str, classes, false);
+}
+
+uint64 avStringSpanNotClass(AvString str, byte classes) {
+	return stringSpan(str, classes, true);
+}
+
+// the compare kernels return the index of the first byte that differs, or length if there is none.
+// tails shorter than a vector are compared in overlapping words instead of byte by byte
+
+static inline uint64 loadWord(const char* data) {
+	uint64 word;
+	memcpy(&word, data, sizeof(uint64));
+	return word;
+}
+
+static inline uint32 loadHalfWord(const char* data) {
+	uint32 word;
+	memcpy(&word, data, sizeof(uint32));
+	return word;
+}
+
+AV_HOT_KERNEL static uint64 findMismatchShort(const char* a, const char* b, uint64 length) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	// the lowest differing byte of a little endian word is the first differing character
+	if (length >= 8) {
+		uint64 difference = loadWord(a) ^ loadWord(b);
+		if (difference) {
+			return __builtin_ctzll(difference) / 8;
+		}
+		difference = loadWord(a + length - 8) ^ loadWord(b + length - 8);
+		return difference ? length - 8 + __builtin_ctzll(difference) / 8 : length;
+	}
+	if (length >= 4) {
+		uint32 difference = loadHalfWord(a) ^ loadHalfWord(b);
+		if (difference) {
+			return __builtin_ctz(difference) / 8;
+		}
+		difference = loadHalfWord(a + length - 4) ^ loadHalfWord(b + length - 4);
+		return difference ? length - 4 + __builtin_ctz(difference) / 8 : length;
+	}
+#endif
+	for (uint64 i = 0; i < length; i++) {
+		if (a[i] != b[i]) {
+			return i;
+		}
+	}
+	return length;
+}
+
+AV_HOT_KERNEL static uint64 findMismatch(const char* a, const char* b, uint64 length) {
+#ifdef AV_STRING_SSE2
+	if (length >= 16) {
+		uint64 i = 0;
+		for (; i + 16 <= length; i += 16) {
+			__m128i blockA = _mm_loadu_si128((const __m128i*)(a + i));
+			__m128i blockB = _mm_loadu_si128((const __m128i*)(b + i));
+			uint32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) ^ 0xFFFF;
+			if (mask) {
+				return i + __builtin_ctz(mask);
+			}
+		}
+		if (i == length) {
+			return length;
+		}
+		// the last block overlaps bytes that are known to be equal
+		i = length - 16;
+		__m128i blockA = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i blockB = _mm_loadu_si128((const __m128i*)(b + i));
+		uint32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) ^ 0xFFFF;
+		return mask ? i + __builtin_ctz(mask) : length;
+	}
+#endif
+	return findMismatchShort(a, b, length);
+}
+
+static inline char foldChar(char chr) {
+	return avCharToLowercase(chr);
+}
+
+AV_HOT_KERNEL static uint64 findMismatchFoldedScalar(const char* a, const char* b, uint64 start, uint64 length) {
+	for (uint64 i = start; i < length; i++) {
+		if (foldChar(a[i]) != foldChar(b[i])) {
+			return i;
+		}
+	}
+	return length;
+}
+
+#ifdef AV_STRING_SSE2
+// lowercases the ascii letters of a block, bytes above 0x7f are negative and never fall in the range
+static inline __m128i foldBlock(__m128i block) {
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+	return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+AV_HOT_KERNEL static uint64 findMismatchFolded(const char* a, const char* b, uint64 length) {
+	uint64 i = 0;
+#ifdef AV_STRING_SSE2
+	for (; i + 16 <= length; i += 16) {
+		__m128i blockA = foldBlock(_mm_loadu_si128((const __m128i*)(a + i)));
+		__m128i blockB = foldBlock(_mm_loadu_si128((const __m128i*)(b + i)));
+		uint32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) ^ 0xFFFF;
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+	if (i != length && length >= 16) {
+		i = length - 16;
+		__m128i blockA = foldBlock(_mm_loadu_si128((const __m128i*)(a + i)));
+		__m128i blockB = foldBlock(_mm_loadu_si128((const __m128i*)(b + i)));
+		uint32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) ^ 0xFFFF;
+		return mask ? i + __builtin_ctz(mask) : length;
+	}
+#endif
+	return findMismatchFoldedScalar(a, b, i, length);
+}
+
+#ifdef AV_STRING_SSE2
+STRING_AVX2_KERNEL static uint64 findMismatchAvx2(const char* a, const char* b, uint64 length) {
+	uint64 i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i blockA = _mm256_loadu_si256((const __m256i*)(a + i));
+		__m256i blockB = _mm256_loadu_si256((const __m256i*)(b + i));
+		uint32 mask = ~(uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockA, blockB));
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+	return i + findMismatch(a + i, b + i, length - i);
+}
+
+STRING_AVX2_KERNEL static uint64 findMismatchFoldedAvx2(const char* a, const char* b, uint64 length) {
+	__m256i below = _mm256_set1_epi8('A' - 1);
+	__m256i above = _mm256_set1_epi8('Z' + 1);
+	__m256i caseBit = _mm256_set1_epi8(0x20);
+	uint64 i = 0;
+	for (; i + 32 <= length; i += 32) {
+		__m256i blockA = _mm256_loadu_si256((const __m256i*)(a + i));
+		__m256i blockB = _mm256_loadu_si256((const __m256i*)(b + i));
+		__m256i upperA = _mm256_and_si256(_mm256_cmpgt_epi8(blockA, below), _mm256_cmpgt_epi8(above, blockA));
+		__m256i upperB = _mm256_and_si256(_mm256_cmpgt_epi8(blockB, below), _mm256_cmpgt_epi8(above, blockB));
+		blockA = _mm256_or_si256(blockA, _mm256_and_si256(upperA, caseBit));
+		blockB = _mm256_or_si256(blockB, _mm256_and_si256(upperB, caseBit));
+		uint32 mask = ~(uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockA, blockB));
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+	return i + findMismatchFolded(a + i, b + i, length - i);
+}
+#endif
+
+static uint64 stringMismatch(const char* a, const char* b, uint64 length) {
+	if (a == b) {
+		return length;
+	}
+#ifdef AV_STRING_SSE2
+	if (length >= 64 && cpuHasAvx2()) {
+		return findMismatchAvx2(a, b, length);
+	}
+#endif
+	return findMismatch(a, b, length);
+}
+
+static uint64 stringMismatchFolded(const char* a, const char* b, uint64 length) {
+	if (a == b) {
+		return length;
+	}
+#ifdef AV_STRING_SSE2
+	if (length >= 64 && cpuHasAvx2()) {
+		return findMismatchFoldedAvx2(a, b, length);
+	}
+#endif
+	return findMismatchFolded(a, b, length);
 }
 
 bool32 avStringEquals(AvString strA, AvString strB) {
 	if (strA.len != strB.len) {
 		return false;
 	}
-	for (uint64 i = 0; i < strA.len; i++) {
-		if (strA.chrs[i] != strB.chrs[i]) {
-			return false;
-		}
+	return stringMismatch(strA.chrs, strB.chrs, strA.len) == strA.len;
+}
+
+bool32 avStringEqualsHashed(AvString strA, uint64 hashA, AvString strB, uint64 hashB) {
+	if (hashA != hashB || strA.len != strB.len) {
+		return false;
 	}
-	return true;
+	return stringMismatch(strA.chrs, strB.chrs, strA.len) == strA.len;
 }
 
 bool32 avStringEqualsCaseInsensitive(AvString strA, AvString strB) {
 	if (strA.len != strB.len) {
 		return false;
 	}
-	for (uint64 i = 0; i < strA.len; i++) {
-		if (!avCharEqualsCaseInsensitive(strA.chrs[i], strB.chrs[i])) {
-			return false;
-		}
-	}
-	return true;
+	return stringMismatchFolded(strA.chrs, strB.chrs, strA.len) == strA.len;
 }
 
 int32 avStringCompare(AvString strA, AvString strB) {
-
-	for (uint64 i = 0; i < AV_MIN(strA.len, strB.len); i++) {
-		if (strA.chrs[i] == strB.chrs[i]) {
-			continue;
-		}
-		return (strA.chrs[i] < strB.chrs[i]) ? -1 : 1;
+	uint64 length = AV_MIN(strA.len, strB.len);
+	uint64 index = stringMismatch(strA.chrs, strB.chrs, length);
+	if (index != length) {
+		return (strA.chrs[index] < strB.chrs[index]) ? -1 : 1;
 	}
 
 	if (strA.len == strB.len) {
@@ -683,16 +1295,34 @@ int32 avStringCompare(AvString strA, AvString strB) {
 
 }
 
+int32 avStringCompareCaseInsensitive(AvString strA, AvString strB) {
+	uint64 length = AV_MIN(strA.len, strB.len);
+	uint64 index = stringMismatchFolded(strA.chrs, strB.chrs, length);
+	if (index != length) {
+		return (foldChar(strA.chrs[index]) < foldChar(strB.chrs[index])) ? -1 : 1;
+	}
+
+	if (strA.len == strB.len) {
+		return 0;
+	}
+
+	return strA.len < strB.len ? -1 : 1;
+}
+
 void avStringReplaceChar(AvStringRef str, char original, char replacement) {
 	if (str->memory == nullptr) {
 		avStringClone(str, *str);
 	}
 
-	for (uint64 i = 0; i < str->len; i++) {
-		if (str->memory->data[i] == original) {
-			str->memory->data[i] = replacement;
-		}
+	// the string may be a section that does not start at the beginning of its memory
+	char* data = str->memory->data + (str->chrs - str->memory->data);
+#ifdef AV_STRING_SSE2
+	if (cpuHasAvx2()) {
+		replaceCharAvx2(data, str->len, original, replacement);
+		return;
 	}
+#endif
+	replaceChar(data, str->len, original, replacement);
 }
 
 uint64 avStringReplaceAll(AvStringRef dst, AvString str, uint32 count, uint64 stride, AvString* sequences, AvString* replacements){
@@ -708,123 +1338,37 @@ uint64 avStringReplaceAll(AvStringRef dst, AvString str, uint32 count, uint64 st
 		memcpy(dst, &tmpStr, sizeof(AvString));
 		return 0;
 	}
-	uint64* counts = avCallocate(count, sizeof(uint64), "counts");
-	uint64 totalCount = 0;
-	for(uint32 i = 0; i < count; i++){
-		counts[i] = avStringFindCount(str, *((AvString*)((byte*)sequences+(i*stride))));
-		totalCount += counts[i];
-	}
-
-	if(totalCount==0){
-		avStringClone(dst, str);
-		avFree(counts);
-		return 0;
-	}
-
-	uint64 remainingLength = str.len;
-	uint64 replacementLength = 0;
-	for(uint32 i = 0; i < count; i++){
-		remainingLength -= counts[i] * ((AvString*)((byte*)sequences+(i*stride)))->len;
-		replacementLength += counts[i] * ((AvString*)((byte*)replacements+(i*stride)))->len;
-	}
-	avFree(counts);
-	uint64 newLength = remainingLength + replacementLength;
-	AvStringHeapMemory memory;
-	avStringMemoryHeapAllocate(newLength, &memory);
-
-	uint64 writeIndex = 0;
-	uint64 readIndex = 0;
-	uint64 countReplaced = 0;
-
-	while (countReplaced != totalCount) {
-		AvString remainingStr = AV_STR(
-			str.chrs + readIndex,
-			str.len - readIndex
-		);
-		uint32 closestSequence = -1;
-		strOffset closestOffset = -1;
-		for(uint32 i = 0; i < count; i++){
-			strOffset offset = avStringFindFirstOccuranceOf(
-				remainingStr,
-				*((AvString*)((byte*)sequences+(i*stride)))
-			);
-			if(offset==AV_STRING_NULL){
-				continue;
-			}
-			if((uint64)offset < closestOffset){
-				closestSequence = i;
-				closestOffset = offset;
-			}
-		}
-
-		avAssert(closestSequence!=-1, "error");
-		
-		strOffset offset = closestOffset;
-		avStringMemoryStore(remainingStr, writeIndex, offset, memory);
-		readIndex += offset;
-		
-		
-		writeIndex += offset;
-		avStringMemoryStore(*((AvString*)((byte*)replacements+(closestSequence*stride))), writeIndex, ((AvString*)((byte*)replacements+(closestSequence*stride)))->len, memory);
-		readIndex += ((AvString*)((byte*)sequences+(closestSequence*stride)))->len;
-		writeIndex += ((AvString*)((byte*)replacements+(closestSequence*stride)))->len;
-		countReplaced++;
-	}
-	AvString remainingStr = AV_STR(
-		str.chrs + readIndex,
-		str.len - readIndex
-	);
-	avStringMemoryStore(remainingStr, writeIndex, remainingStr.len, memory);
-
-	avStringFromMemory(dst, AV_STRING_WHOLE_MEMORY, memory);
-	return totalCount;
-
+	// all sequences are searched for in a single pass, reuse an AvStringMatcher when replacing the same sequences repeatedly
+	AvStringMatcher matcher;
+	avStringMatcherCreate(count, stride, sequences, &matcher);
+	uint64 replaced = avStringMatcherReplace(dst, str, stride, replacements, matcher);
+	avStringMatcherDestroy(matcher);
+	return replaced;
 }
 
 uint64 avStringReplace(AvStringRef dst, AvString str, AvString sequence, AvString replacement) {
 	avAssert(dst != nullptr, "destination must be a valid reference");
 
-	uint64 count = avStringFindCount(str, sequence);
-
-	if (count == 0) {
+	uint64 offset = sequence.len ? searchForward(str.chrs, str.len, 0, sequence.chrs, sequence.len) : AV_STRING_NULL;
+	if (offset == AV_STRING_NULL) {
 		avStringClone(dst, str);
 		return 0;
 	}
 
-	uint64 remainingLength = str.len - count * sequence.len;
-	uint64 newLength = remainingLength + count * replacement.len;
-	AvStringHeapMemory memory;
-	avStringMemoryHeapAllocate(newLength, &memory);
-
-
-	uint64 writeIndex = 0;
+	// the builder also covers a result that ends up empty
+	AvStringBuilder builder;
+	avStringBuilderCreate(str.len, &builder);
+	uint64 count = 0;
 	uint64 readIndex = 0;
-	uint64 countReplaced = 0;
-
-	while (countReplaced != count) {
-		AvString remainingStr = AV_STR(
-			str.chrs + readIndex,
-			str.len - readIndex
-		);
-		strOffset offset = avStringFindFirstOccuranceOf(
-			remainingStr,
-			sequence
-		);
-		avStringMemoryStore(remainingStr, writeIndex, offset, memory);
-		readIndex += offset;
-		writeIndex += offset;
-		avStringMemoryStore(replacement, writeIndex, replacement.len, memory);
-		readIndex += sequence.len;
-		writeIndex += replacement.len;
-		countReplaced++;
-	}
-	AvString remainingStr = AV_STR(
-		str.chrs + readIndex,
-		str.len - readIndex
-	);
-	avStringMemoryStore(remainingStr, writeIndex, remainingStr.len, memory);
-
-	avStringFromMemory(dst, AV_STRING_WHOLE_MEMORY, memory);
+	while (offset != AV_STRING_NULL) {
+		avStringBuilderAppend(AV_STR(str.chrs + readIndex, offset - readIndex), &builder);
+		avStringBuilderAppend(replacement, &builder);
+		readIndex = offset + sequence.len;
+		count++;
+		offset = searchForward(str.chrs, str.len, readIndex, sequence.chrs, sequence.len);
+	}
+	avStringBuilderAppend(AV_STR(str.chrs + readIndex, str.len - readIndex), &builder);
+	avStringBuilderFinish(dst, &builder);
 	return count;
 }
 
@@ -833,33 +1377,20 @@ void avStringUnsafeCopy(AvStringRef dst, AvString src){
 }
 
 void avStringJoin_(AvStringRef dst, ...) {
+	avAssert(dst != nullptr, "destination must be a valid reference");
 	va_list strs;
 	va_start(strs, dst);
-	AvDynamicArray arr;
-	avDynamicArrayCreate(0, sizeof(AvString), &arr);
-	uint64 length = 0;
+	AvStringBuilder builder;
+	avStringBuilderCreate(0, &builder);
 	while (true) {
 		AvString str = va_arg(strs, AvString);
 		if (str.len == AV_STRING_NULL) {
 			break;
 		}
-		length += str.len;
-		avDynamicArrayAdd(&str, arr);
+		avStringBuilderAppend(str, &builder);
 	}
-
-	avAssert(dst != nullptr, "destination must be a valid reference");
-
-	AvStringHeapMemory memory;
-	avStringMemoryHeapAllocate(length, &memory);
-
-	uint64 writeIndex = 0;
-	avDynamicArrayForEachElement(AvString, arr, {
-		avStringMemoryStore(element, writeIndex, element.len, memory);
-		writeIndex += element.len;
-		});
-	avDynamicArrayDestroy(arr);
-
-	avStringFromMemory(dst, AV_STRING_WHOLE_MEMORY, memory);
+	va_end(strs);
+	avStringBuilderFinish(dst, &builder);
 }
 
 void avStringAppendChar(AvStringRef str, char c){
@@ -883,6 +1414,123 @@ void avStringAppend(AvStringRef dst, AvString src) {
 	avStringFromMemory(dst, AV_STRING_WHOLE_MEMORY, memory);
 }
 
+#define STRING_BUILDER_MIN_CAPACITY 16
+
+void avStringBuilderCreate(uint64 initialCapacity, AvStringBuilder* builder) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	memset(builder, 0, sizeof(AvStringBuilder));
+	if (initialCapacity) {
+		avStringBuilderReserve(initialCapacity, builder);
+	}
+}
+
+void avStringBuilderDestroy(AvStringBuilder* builder) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	if (builder->data) {
+		avFree(builder->data);
+	}
+	memset(builder, 0, sizeof(AvStringBuilder));
+}
+
+void avStringBuilderReserve(uint64 capacity, AvStringBuilder* builder) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	if (capacity <= builder->capacity) {
+		return;
+	}
+	// grow geometrically so a sequence of appends only copies the data a constant number of times
+	capacity = AV_MAX(capacity, AV_MAX(builder->capacity * 2, STRING_BUILDER_MIN_CAPACITY));
+	builder->data = avReallocate(builder->data, capacity + NULL_TERMINATOR_SIZE, "resizing string builder");
+	builder->capacity = capacity;
+}
+
+void avStringBuilderAppend(AvString str, AvStringBuilder* builder) {
+	if (str.len == 0) {
+		return;
+	}
+	avStringBuilderReserve(builder->length + str.len, builder);
+	memcpy(builder->data + builder->length, str.chrs, str.len);
+	builder->length += str.len;
+}
+
+void avStringBuilderAppendChar(char chr, AvStringBuilder* builder) {
+	avStringBuilderReserve(builder->length + 1, builder);
+	builder->data[builder->length++] = chr;
+}
+
+void avStringBuilderAppendRepeat(char chr, uint64 count, AvStringBuilder* builder) {
+	if (count == 0) {
+		return;
+	}
+	avStringBuilderReserve(builder->length + count, builder);
+	memset(builder->data + builder->length, chr, count);
+	builder->length += count;
+}
+
+void avStringBuilderAppendf(AvStringBuilder* builder, AvString format, ...) {
+	va_list args;
+	va_start(args, format);
+	avStringBuilderAppendfVA(builder, format, args);
+	va_end(args);
+}
+
+void avStringBuilderAppendfVA(AvStringBuilder* builder, AvString format, va_list args) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	// print into the free space, when the output fills it completely it may have been cut off so grow and retry
+	avStringBuilderReserve(builder->length + format.len + STRING_BUILDER_MIN_CAPACITY, builder);
+	while (true) {
+		uint64 available = AV_MIN(builder->capacity - builder->length, (uint64)UINT32_MAX);
+		va_list copy;
+		va_copy(copy, args);
+		uint64 written = avStringPrintfToBufferVA(builder->data + builder->length, (uint32)available, format, copy);
+		va_end(copy);
+		if (written < available) {
+			builder->length += written;
+			return;
+		}
+		avStringBuilderReserve(builder->capacity * 2, builder);
+	}
+}
+
+void avStringBuilderTruncate(uint64 length, AvStringBuilder* builder) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	builder->length = AV_MIN(builder->length, length);
+}
+
+void avStringBuilderClear(AvStringBuilder* builder) {
+	avStringBuilderTruncate(0, builder);
+}
+
+AvString avStringBuilderView(AvStringBuilder* builder) {
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	return AV_STR(builder->data, builder->length);
+}
+
+void avStringBuilderFinish_(AvStringRef dst, AvStringBuilder* builder, const char* file, uint32 line) {
+	avAssert(dst != nullptr, "destination must be a valid reference");
+	avAssert(builder != nullptr, "builder must be a valid reference");
+	if (dst->memory) {
+		avStringFree(dst);
+	}
+	if (builder->length == 0) {
+		avStringBuilderDestroy(builder);
+		avStringUnsafeCopy(dst, AV_EMPTY_STRING);
+		return;
+	}
+	// the builder buffer becomes the string data, the unused capacity stays allocated until the string is freed
+	AvStringHeapMemory memory = avCallocate(1, sizeof(AvStringMemory), "allocating string memory on heap");
+	memory->properties.heapAllocated = true;
+	memory->data = builder->data;
+	memory->data[builder->length] = '\0';
+	memory->capacity = builder->length;
+	memory->properties.allocationLine = line;
+	memory->properties.allocationFile = file;
+#ifndef NDEBUG
+	addAllocation(memory);
+#endif
+	memset(builder, 0, sizeof(AvStringBuilder));
+	avStringFromMemory(dst, AV_STRING_WHOLE_MEMORY, memory);
+}
+
 void avStringMemoryStoreCharArraysVA_(AvStringMemoryRef memory, ...) {
 
 	AvDynamicArray arr;
@@ -1021,7 +1669,7 @@ uint32 avStringSplitOnChar(AV_DS(AvArrayRef, AvString) substrings, char split, A
 	avAssert(str.len > 0, "split must be a valid string");
 	avAssert(str.chrs != nullptr, "split must be a valid string");
 
-	uint splitCount = split == '\0' ? str.len : avStringFindCharCount(str, split);
+	uint splitCount = avStringFindCharCount(str, split);
 	avArrayAllocateWithFreeCallback(splitCount + 1, sizeof(AvString), substrings, false, nullptr, (AvDestroyElementCallback)&avStringFree);
 	if (splitCount == 0) {
 		avStringCopy(avArrayGetPtr(0, substrings), str);
@@ -1029,19 +1677,15 @@ uint32 avStringSplitOnChar(AV_DS(AvArrayRef, AvString) substrings, char split, A
 	}
 
 	uint64 substrStart = 0;
-	uint64 subStrEnd = 0;
 	uint32 index = 0;
-	for (uint64 i = 0; i < str.len; i++) {
-		if (str.chrs[i] == split) {
-			uint64 len = subStrEnd - substrStart;
-			avStringCopySection(avArrayGetPtr(index++, substrings), substrStart, len, str);
-			substrStart = subStrEnd + 1;
-		}
-		subStrEnd++;
-	}
-	uint64 len = subStrEnd - substrStart;
-	avStringCopySection(avArrayGetPtr(index++, substrings), substrStart, len, str);
-	return splitCount;
+	while (index < splitCount) {
+		const char* found = memchr(str.chrs + substrStart, split, str.len - substrStart);
+		uint64 substrEnd = found - str.chrs;
+		avStringCopySection(avArrayGetPtr(index++, substrings), substrStart, substrEnd - substrStart, str);
+		substrStart = substrEnd + 1;
+	}
+	avStringCopySection(avArrayGetPtr(index++, substrings), substrStart, str.len - substrStart, str);
+	return splitCount + 1;
 }
 
 uint32 avStringSplit(AV_DS(AvArrayRef, AvString) substrings, AvString split, AvString str) {
@@ -1050,19 +1694,20 @@ uint32 avStringSplit(AV_DS(AvArrayRef, AvString) substrings, AvString split, AvS
 	avAssert(str.len > 0, "split must be a valid string");
 	avAssert(str.chrs != nullptr, "split must be a valid string");
 
-	uint splitCount = split.len == 0 ? str.len : avStringFindCount(str, split);
+	// an empty separator never matches, the whole string is returned
+	uint splitCount = avStringFindCount(str, split);
 	avArrayAllocateWithFreeCallback(splitCount + 1, sizeof(AvString), substrings, false, nullptr, (AvDestroyElementCallback)&avStringFree);
 	if (splitCount == 0) {
 		avStringCopy(avArrayGetPtr(0, substrings), str);
 		return 1;
 	}
 
-	uint32 offset = 0;
+	uint64 offset = 0;
 	uint32 index = 0;
 
 	uint32 count = 0;
 	while (count != splitCount) {
-		strOffset sectionLength = avStringFindFirstOccuranceOf(AV_STR(str.chrs + offset, str.len - offset), split);
+		uint64 sectionLength = searchForward(str.chrs, str.len, offset, split.chrs, split.len) - offset;
 		avStringCopySection(avArrayGetPtr(index++, substrings), offset, sectionLength, str);
 		offset += sectionLength + split.len;
 		count++;
@@ -1072,6 +1717,89 @@ uint32 avStringSplit(AV_DS(AvArrayRef, AvString) substrings, AvString split, AvS
 	return splitCount+1;
 }
 
+void avStringSplitIteratorCreate(AvString str, AvString delimiter, uint32 maxSplits, AvStringSplitFlags flags, AvStringSplitIterator* iterator) {
+	avAssert(iterator != nullptr, "iterator must be a valid reference");
+	AvStringSplitIterator it = {
+		.chrs = str.chrs,
+		.length = str.len,
+		.delimiter = delimiter.chrs,
+		.delimiterLength = delimiter.len,
+		.delimiterChar = delimiter.len ? delimiter.chrs[0] : '\0',
+		.maxSplits = maxSplits,
+		.flags = flags,
+	};
+	memcpy(iterator, &it, sizeof(AvStringSplitIterator));
+}
+
+void avStringSplitIteratorCreateOnChar(AvString str, char delimiter, uint32 maxSplits, AvStringSplitFlags flags, AvStringSplitIterator* iterator) {
+	avStringSplitIteratorCreate(str, AV_STR(nullptr, 0), maxSplits, flags, iterator);
+	iterator->delimiterChar = delimiter;
+	iterator->delimiterLength = 1;
+}
+
+// returns the offset of the next delimiter at or after start, or the length of the string
+static uint64 findDelimiter(uint64 start, AvStringSplitIterator* iterator) {
+	if (iterator->delimiterLength == 1) {
+		const char* found = memchr(iterator->chrs + start, iterator->delimiterChar, iterator->length - start);
+		return found ? (uint64)(found - iterator->chrs) : iterator->length;
+	}
+	uint64 offset = searchForward(iterator->chrs, iterator->length, start, iterator->delimiter, iterator->delimiterLength);
+	return offset == AV_STRING_NULL ? iterator->length : offset;
+}
+
+static bool32 delimiterAt(uint64 offset, AvStringSplitIterator* iterator) {
+	if (iterator->length - offset < iterator->delimiterLength) {
+		return false;
+	}
+	if (iterator->delimiterLength == 1) {
+		return iterator->chrs[offset] == iterator->delimiterChar;
+	}
+	return memcmp(iterator->chrs + offset, iterator->delimiter, iterator->delimiterLength) == 0;
+}
+
+bool32 avStringSplitNext(AvStringRef substring, AvStringSplitIterator* iterator) {
+	avAssert(substring != nullptr, "substring must be a valid reference");
+	avAssert(iterator != nullptr, "iterator must be a valid reference");
+	bool32 skipEmpty = iterator->flags & AV_STRING_SPLIT_SKIP_EMPTY;
+	while (!iterator->finished) {
+		uint64 start = iterator->position;
+		bool32 remainder = iterator->maxSplits && iterator->fieldCount == iterator->maxSplits;
+		uint64 end;
+		if (remainder || iterator->delimiterLength == 0) {
+			if (remainder && skipEmpty) {
+				while (delimiterAt(start, iterator)) {
+					start += iterator->delimiterLength;
+				}
+			}
+			end = iterator->length;
+		} else {
+			end = findDelimiter(start, iterator);
+		}
+
+		if (end == iterator->length) {
+			iterator->finished = true;
+		} else {
+			iterator->position = end + iterator->delimiterLength;
+		}
+		if (skipEmpty && end == start) {
+			continue;
+		}
+		iterator->fieldCount++;
+		avStringUnsafeCopy(substring, AV_STR(iterator->chrs + start, end - start));
+		return true;
+	}
+	return false;
+}
+
+uint32 avStringSplitNextBatch(AvString* substrings, uint32 capacity, AvStringSplitIterator* iterator) {
+	avAssert(substrings != nullptr || capacity == 0, "substrings must be a valid array");
+	uint32 count = 0;
+	while (count < capacity && avStringSplitNext(&substrings[count], iterator)) {
+		count++;
+	}
+	return count;
+}
+
 void avStringFlip(AvStringRef dst, AvString src) {
 	avAssert(dst != nullptr, "string must be a valid reference");
 	
@@ -1220,35 +1948,36 @@ void avStringPathNormalize(AvStringRef path){
 		avDynamicArrayAdd(&segment, stack);
 	}
 
-	AvString normalized = AV_EMPTY;
+	AvStringBuilder normalized;
+	avStringBuilderCreate(path->len, &normalized);
 
 #ifdef _WIN32
     // Preserve drive letter
     if (isAbsolute && path->len > 1 && path->chrs[1] == ':') {
-        avStringAppendChar(&normalized, path->chrs[0]);
-        avStringAppendChar(&normalized, ':');
-        avStringAppendChar(&normalized, separator);
+        avStringBuilderAppendChar(path->chrs[0], &normalized);
+        avStringBuilderAppendChar(':', &normalized);
+        avStringBuilderAppendChar(separator, &normalized);
     } else if (isAbsolute) {
-        avStringAppendChar(&normalized, separator);
+        avStringBuilderAppendChar(separator, &normalized);
     }
 #else
-    if (isAbsolute) avStringAppendChar(&normalized, separator);
+    if (isAbsolute) avStringBuilderAppendChar(separator, &normalized);
 #endif
 
 	uint32 stackSize = avDynamicArrayGetSize(stack);
 
 	for(uint32 i = 0; i < stackSize; i++){
 		AvString* seg = avDynamicArrayGetPtr(i, stack);
-		if(normalized.len > 0 && normalized.chrs[normalized.len-1]!=separator){
-			avStringAppendChar(&normalized, separator);
+		if(normalized.length > 0 && normalized.data[normalized.length-1]!=separator){
+			avStringBuilderAppendChar(separator, &normalized);
 		}
-		avStringAppend(&normalized, *seg);
+		avStringBuilderAppend(*seg, &normalized);
 		avStringFree(seg);
 	}
 
 	avDynamicArrayDestroy(stack);
 	avStringFree(path);
-	avStringMove(path, &normalized);
+	avStringBuilderFinish(path, &normalized);
 }
 
 
@@ -1259,32 +1988,20 @@ void avStringPathResolveRelative(AvStringRef dst, AvString baseFile, AvString re
 		return;
 	}
 
-	AvString baseDir = AV_EMPTY;
-	avStringClone(&baseDir, baseFile);
-
-	strOffset lastSlash = avStringFindLastOccuranceOfChar(baseDir, '/');
+	strOffset lastSlash = avStringFindLastOccuranceOfChar(baseFile, '/');
 	
 #ifdef _WIN32
-	strOffset lastBackslash = avStringFindLastOccuranceOfChar(baseDir, '\\');
+	strOffset lastBackslash = avStringFindLastOccuranceOfChar(baseFile, '\\');
 	if(lastBackslash > lastSlash) lastSlash = lastBackslash;
 #endif
-	AvString combined = AV_EMPTY;
-
+	AvStringBuilder combined;
+	avStringBuilderCreate(baseFile.len + relativePath.len, &combined);
 
 	if(lastSlash >= 0){
-		AvString dirOnly = AV_EMPTY;
-		avStringCopySection(&dirOnly, 0, lastSlash+1, baseDir);
-
-		avStringJoin(&combined, dirOnly, relativePath);
-		avStringFree(&dirOnly);
-	}else{
-		avStringClone(&combined, relativePath);
+		avStringBuilderAppend(AV_STR(baseFile.chrs, lastSlash+1), &combined);
 	}
-
-	avStringFree(&baseDir);
-
-	avStringClone(dst, combined);
-	avStringFree(&combined);
+	avStringBuilderAppend(relativePath, &combined);
+	avStringBuilderFinish(dst, &combined);
 
 	avStringPathNormalize(dst);
 }
@@ -0,0 +1,177 @@
+#include <AvUtils/string/avStringIntern.h>
+#include <AvUtils/memory/avDynamicAllocator.h>
+#include <AvUtils/threading/avRwLock.h>
+#include <AvUtils/util/avHash.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+
+#define INTERN_INITIAL_CAPACITY 64
+#define INTERN_ARENA_PAGE_SIZE (1 << 16)
+
+typedef struct InternEntry {
+	uint64 hash;
+	AvString str;
+} InternEntry;
+
+typedef struct AvStringInternPool_T {
+	AvDynamicAllocator arena;
+	InternEntry* entries;
+	uint64 capacity;
+	uint32 count;
+	AvRwLock lock;
+} AvStringInternPool_T;
+
+static const char emptyString[1] = { '\0' };
+
+void avStringInternPoolCreate(bool32 threadSafe, AvStringInternPool* pool) {
+	avAssert(pool != nullptr, "pool must be a valid reference");
+	(*pool) = avCallocate(1, sizeof(AvStringInternPool_T), "allocating string intern pool");
+	avDynamicAllocatorCreate(INTERN_ARENA_PAGE_SIZE, &(*pool)->arena);
+	(*pool)->capacity = INTERN_INITIAL_CAPACITY;
+	(*pool)->entries = avCallocate(INTERN_INITIAL_CAPACITY, sizeof(InternEntry), "allocating string intern table");
+	if (threadSafe) {
+		avRWLockCreate(&(*pool)->lock);
+	}
+}
+
+void avStringInternPoolDestroy(AvStringInternPool pool) {
+	if (pool->lock) {
+		avRWLockDestroy(pool->lock);
+	}
+	avDynamicAllocatorDestroy(&pool->arena);
+	avFree(pool->entries);
+	avFree(pool);
+}
+
+// the table never contains removed entries so an empty chrs pointer terminates a probe
+static InternEntry* findEntry(uint64 hash, AvString str, AvStringInternPool pool) {
+	uint64 mask = pool->capacity - 1;
+	uint64 index = hash & mask;
+	while (true) {
+		InternEntry* entry = &pool->entries[index];
+		if (entry->str.chrs == nullptr) {
+			return entry;
+		}
+		if (entry->hash == hash && entry->str.len == str.len && memcmp(entry->str.chrs, str.chrs, str.len) == 0) {
+			return entry;
+		}
+		index = (index + 1) & mask;
+	}
+}
+
+static void grow(AvStringInternPool pool) {
+	InternEntry* oldEntries = pool->entries;
+	uint64 oldCapacity = pool->capacity;
+	pool->capacity *= 2;
+	pool->entries = avCallocate(pool->capacity, sizeof(InternEntry), "allocating string intern table");
+	uint64 mask = pool->capacity - 1;
+	for (uint64 i = 0; i < oldCapacity; i++) {
+		if (oldEntries[i].str.chrs == nullptr) {
+			continue;
+		}
+		uint64 index = oldEntries[i].hash & mask;
+		while (pool->entries[index].str.chrs != nullptr) {
+			index = (index + 1) & mask;
+		}
+		memcpy(&pool->entries[index], &oldEntries[i], sizeof(InternEntry));
+	}
+	avFree(oldEntries);
+}
+
+static bool32 lookup(uint64 hash, AvString str, AvString* interned, AvStringInternPool pool) {
+	InternEntry* entry = findEntry(hash, str, pool);
+	if (entry->str.chrs == nullptr) {
+		return false;
+	}
+	avStringUnsafeCopy(interned, entry->str);
+	return true;
+}
+
+static AvString insert(uint64 hash, AvString str, AvStringInternPool pool) {
+	if ((uint64)(pool->count + 1) * 4 > pool->capacity * 3) {
+		grow(pool);
+	}
+	InternEntry* entry = findEntry(hash, str, pool);
+	if (entry->str.chrs != nullptr) {
+		return entry->str;
+	}
+	char* chrs = avDynamicAllocatorAllocate(str.len + 1, &pool->arena);
+	memcpy(chrs, str.chrs, str.len);
+	chrs[str.len] = '\0';
+	entry->hash = hash;
+	avStringUnsafeCopy(&entry->str, AV_STR(chrs, str.len));
+	pool->count++;
+	return entry->str;
+}
+
+AvString avStringIntern(AvString str, AvStringInternPool pool) {
+	AvString interned = AV_EMPTY;
+	avStringInternBulk(&interned, &str, 1, pool);
+	return interned;
+}
+
+void avStringInternBulk(AvString* dst, const AvString* src, uint32 count, AvStringInternPool pool) {
+	avAssert(dst != nullptr, "destination must be a valid array");
+	avAssert(src != nullptr, "source must be a valid array");
+
+	// most strings in a bulk call are expected to be present, so try them all under the shared lock first
+	uint32 missing = 0;
+	if (pool->lock) {
+		avRWLockReadLock(pool->lock);
+	}
+	for (uint32 i = 0; i < count; i++) {
+		AvString str = src[i];
+		if (str.len == 0) {
+			avStringUnsafeCopy(&dst[i], AV_STR(emptyString, 0));
+			continue;
+		}
+		if (!lookup(avStringHash(str), str, &dst[i], pool)) {
+			avStringUnsafeCopy(&dst[i], str);
+			missing++;
+		}
+	}
+	if (pool->lock) {
+		avRWLockReadUnlock(pool->lock);
+	}
+	if (missing == 0) {
+		return;
+	}
+
+	if (pool->lock) {
+		avRWLockWriteLock(pool->lock);
+	}
+	for (uint32 i = 0; i < count; i++) {
+		if (dst[i].chrs == emptyString) {
+			continue;
+		}
+		avStringUnsafeCopy(&dst[i], insert(avStringHash(dst[i]), dst[i], pool));
+	}
+	if (pool->lock) {
+		avRWLockWriteUnlock(pool->lock);
+	}
+}
+
+bool32 avStringInternLookup(AvString str, AvString* interned, AvStringInternPool pool) {
+	avAssert(interned != nullptr, "interned must be a valid reference");
+	if (str.len == 0) {
+		avStringUnsafeCopy(interned, AV_STR(emptyString, 0));
+		return true;
+	}
+	if (pool->lock) {
+		avRWLockReadLock(pool->lock);
+	}
+	bool32 found = lookup(avStringHash(str), str, interned, pool);
+	if (pool->lock) {
+		avRWLockReadUnlock(pool->lock);
+	}
+	return found;
+}
+
+uint32 avStringInternPoolGetCount(AvStringInternPool pool) {
+	return pool->count;
+}
+
+uint64 avStringInternPoolGetMemorySize(AvStringInternPool pool) {
+	return avDynamicAllocatorGetAllocatedSize(&pool->arena) + pool->capacity * sizeof(InternEntry);
+}
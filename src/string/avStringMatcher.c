@@ -0,0 +1,218 @@
+#include <AvUtils/string/avStringMatcher.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+
+#define MATCHER_INITIAL_STATES 64
+#define ROOT_STATE 0
+
+typedef struct MatcherState {
+	uint32 depth; // length of the prefix this state represents
+	uint32 fail; // state of the longest proper suffix that is also a prefix
+	uint32 matchLength; // longest pattern ending in this state, 0 if none
+	uint32 matchPattern;
+} MatcherState;
+
+// bytes that do not occur in any pattern share class 0, so a row of the transition table
+// only needs one column per distinct pattern byte
+typedef struct AvStringMatcher_T {
+	uint32 patternCount;
+	uint32 classCount;
+	byte byteClass[256];
+
+	uint32 stateCount;
+	uint32 stateCapacity;
+	MatcherState* states;
+	// stateCapacity * classCount entries, after compiling every state has a transition for every class
+	uint32* transitions;
+} AvStringMatcher_T;
+
+static const AvString* getPattern(uint32 index, uint64 stride, const AvString* patterns) {
+	return (const AvString*)((const byte*)patterns + index * stride);
+}
+
+static uint32 addState(uint32 depth, AvStringMatcher matcher) {
+	if (matcher->stateCount == matcher->stateCapacity) {
+		uint32 capacity = matcher->stateCapacity * 2;
+		matcher->states = avReallocate(matcher->states, capacity * sizeof(MatcherState), "resizing string matcher states");
+		matcher->transitions = avReallocate(matcher->transitions, (uint64)capacity * matcher->classCount * sizeof(uint32), "resizing string matcher transitions");
+		memset(matcher->transitions + (uint64)matcher->stateCapacity * matcher->classCount, 0, (uint64)(capacity - matcher->stateCapacity) * matcher->classCount * sizeof(uint32));
+		matcher->stateCapacity = capacity;
+	}
+	uint32 state = matcher->stateCount++;
+	memset(&matcher->states[state], 0, sizeof(MatcherState));
+	matcher->states[state].depth = depth;
+	return state;
+}
+
+static void insertPattern(uint32 index, AvString pattern, AvStringMatcher matcher) {
+	avAssert(pattern.len < (uint32)-1, "pattern is too long");
+	uint32 state = ROOT_STATE;
+	for (uint64 i = 0; i < pattern.len; i++) {
+		uint32* transition = &matcher->transitions[(uint64)state * matcher->classCount + matcher->byteClass[(byte)pattern.chrs[i]]];
+		if (*transition == ROOT_STATE) {
+			// addState may move the table
+			uint32 next = addState(i + 1, matcher);
+			transition = &matcher->transitions[(uint64)state * matcher->classCount + matcher->byteClass[(byte)pattern.chrs[i]]];
+			*transition = next;
+		}
+		state = *transition;
+	}
+	// a repeated pattern keeps the first index
+	if (matcher->states[state].matchLength == 0) {
+		matcher->states[state].matchLength = pattern.len;
+		matcher->states[state].matchPattern = index;
+	}
+}
+
+// fills in the failure links breadth first and turns the trie into a complete transition table
+static void compile(AvStringMatcher matcher) {
+	uint32 classCount = matcher->classCount;
+	uint32* queue = avAllocate(matcher->stateCount * sizeof(uint32), "allocating string matcher queue");
+	uint32 head = 0;
+	uint32 tail = 0;
+	queue[tail++] = ROOT_STATE;
+	while (head < tail) {
+		uint32 state = queue[head++];
+		uint32* row = &matcher->transitions[(uint64)state * classCount];
+		const uint32* failRow = &matcher->transitions[(uint64)matcher->states[state].fail * classCount];
+		for (uint32 c = 0; c < classCount; c++) {
+			// the row of a state is only completed when it is dequeued, so a non root entry is still a trie edge
+			if (row[c] == ROOT_STATE) {
+				row[c] = state == ROOT_STATE ? ROOT_STATE : failRow[c];
+				continue;
+			}
+			MatcherState* child = &matcher->states[row[c]];
+			child->fail = state == ROOT_STATE ? ROOT_STATE : failRow[c];
+			// the failure state is shallower and therefore already complete
+			if (child->matchLength == 0) {
+				child->matchLength = matcher->states[child->fail].matchLength;
+				child->matchPattern = matcher->states[child->fail].matchPattern;
+			}
+			queue[tail++] = row[c];
+		}
+	}
+	avFree(queue);
+}
+
+void avStringMatcherCreate(uint32 count, uint64 stride, const AvString* patterns, AvStringMatcher* matcher) {
+	avAssert(matcher != nullptr, "matcher must be a valid reference");
+	avAssert(patterns != nullptr || count == 0, "patterns must be a valid array");
+
+	(*matcher) = avCallocate(1, sizeof(AvStringMatcher_T), "allocating string matcher handle");
+	AvStringMatcher m = *matcher;
+	m->patternCount = count;
+	m->classCount = 1;
+	for (uint32 i = 0; i < count; i++) {
+		const AvString* pattern = getPattern(i, stride, patterns);
+		for (uint64 j = 0; j < pattern->len; j++) {
+			byte chr = (byte)pattern->chrs[j];
+			if (m->byteClass[chr] == 0) {
+				m->byteClass[chr] = m->classCount++;
+			}
+		}
+	}
+
+	m->stateCapacity = MATCHER_INITIAL_STATES;
+	m->states = avAllocate(m->stateCapacity * sizeof(MatcherState), "allocating string matcher states");
+	m->transitions = avCallocate((uint64)m->stateCapacity * m->classCount, sizeof(uint32), "allocating string matcher transitions");
+	addState(0, m);
+	for (uint32 i = 0; i < count; i++) {
+		const AvString* pattern = getPattern(i, stride, patterns);
+		if (pattern->len == 0) {
+			continue;
+		}
+		insertPattern(i, *pattern, m);
+	}
+	compile(m);
+}
+
+void avStringMatcherDestroy(AvStringMatcher matcher) {
+	avFree(matcher->transitions);
+	avFree(matcher->states);
+	avFree(matcher);
+}
+
+uint32 avStringMatcherGetPatternCount(AvStringMatcher matcher) {
+	return matcher->patternCount;
+}
+
+AV_HOT_KERNEL static bool32 findMatch(const char* data, uint64 length, uint64 start, AvStringMatch* match, AvStringMatcher matcher) {
+	const uint32* transitions = matcher->transitions;
+	const MatcherState* states = matcher->states;
+	const byte* byteClass = matcher->byteClass;
+	uint32 classCount = matcher->classCount;
+
+	uint32 state = ROOT_STATE;
+	bool32 found = false;
+	for (uint64 i = start; i < length; i++) {
+		state = transitions[(uint64)state * classCount + byteClass[(byte)data[i]]];
+		// the state is the longest pattern prefix ending here, once it starts after the match
+		// no later match can start earlier or be a longer match at the same offset
+		if (found && i + 1 - states[state].depth > match->offset) {
+			break;
+		}
+		if (states[state].matchLength == 0) {
+			continue;
+		}
+		uint64 offset = i + 1 - states[state].matchLength;
+		if (!found || offset <= match->offset) {
+			found = true;
+			match->offset = offset;
+			match->length = states[state].matchLength;
+			match->pattern = states[state].matchPattern;
+		}
+	}
+	return found;
+}
+
+bool32 avStringMatcherFind(AvString str, uint64 start, AvStringMatch* match, AvStringMatcher matcher) {
+	avAssert(match != nullptr, "match must be a valid reference");
+	return findMatch(str.chrs, str.len, start, match, matcher);
+}
+
+uint64 avStringMatcherForEach(AvStringMatchCallback callback, void* userData, AvString str, AvStringMatcher matcher) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	uint64 visited = 0;
+	AvStringMatch match;
+	uint64 position = 0;
+	while (findMatch(str.chrs, str.len, position, &match, matcher)) {
+		visited++;
+		if (!callback(match, userData)) {
+			break;
+		}
+		position = match.offset + match.length;
+	}
+	return visited;
+}
+
+uint64 avStringMatcherCount(AvString str, AvStringMatcher matcher) {
+	uint64 count = 0;
+	AvStringMatch match;
+	uint64 position = 0;
+	while (findMatch(str.chrs, str.len, position, &match, matcher)) {
+		count++;
+		position = match.offset + match.length;
+	}
+	return count;
+}
+
+uint64 avStringMatcherReplace(AvStringRef dst, AvString str, uint64 stride, const AvString* replacements, AvStringMatcher matcher) {
+	avAssert(dst != nullptr, "destination must be a valid reference");
+	avAssert(replacements != nullptr || matcher->patternCount == 0, "replacements must be a valid array");
+
+	AvStringBuilder builder;
+	avStringBuilderCreate(str.len, &builder);
+	uint64 count = 0;
+	AvStringMatch match;
+	uint64 position = 0;
+	while (findMatch(str.chrs, str.len, position, &match, matcher)) {
+		avStringBuilderAppend(AV_STR(str.chrs + position, match.offset - position), &builder);
+		avStringBuilderAppend(*getPattern(match.pattern, stride, replacements), &builder);
+		position = match.offset + match.length;
+		count++;
+	}
+	avStringBuilderAppend(AV_STR(str.chrs + position, str.len - position), &builder);
+	avStringBuilderFinish(dst, &builder);
+	return count;
+}
@@ -1,13 +1,31 @@
 #include <AvUtils/util/avBitfield.h>
 #include <AvUtils/logging/avAssert.h>
 #include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
 
 #include <string.h>
 
-#define MASK_ONES(remainder) (((byte)0xff)>>(8-(remainder)))
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AV_BITFIELD_X86_64
+#include <emmintrin.h>
+#endif
 
-static inline uint32 getByteCount(uint32 bitCount){
-    return bitCount/8+(bitCount%8!=0);
+#define WORD_BITS 64
+#define WORD_INDEX(bit) ((bit) / WORD_BITS)
+#define WORD_MASK(bit) (1ULL << ((bit) % WORD_BITS))
+
+static inline uint32 getWordCount(uint32 bitCount){
+    return bitCount/WORD_BITS+(bitCount%WORD_BITS!=0);
+}
+
+// mask of the valid bits in the last word
+static inline uint64 getTailMask(uint32 bitCount){
+    uint32 remainder = bitCount % WORD_BITS;
+    return remainder ? (~0ULL >> (WORD_BITS - remainder)) : ~0ULL;
+}
+
+static inline void clearTail(AvBitField bitField){
+    bitField.words[getWordCount(bitField.bitCount) - 1] &= getTailMask(bitField.bitCount);
 }
 
 void avBitFieldCreate(uint32 bitCount, AvBitField* bitField){
@@ -16,7 +34,7 @@ void avBitFieldCreate(uint32 bitCount, AvBitField* bitField){
 
     AvBitField field = {
         .bitCount = bitCount,
-        .bits = avCallocate(getByteCount(bitCount), 1, "allocating bitfield")
+        .words = avCallocate(getWordCount(bitCount), sizeof(uint64), "allocating bitfield")
     };
     memcpy(bitField, &field, sizeof(AvBitField));
 }
@@ -24,7 +42,7 @@ void avBitFieldCreate(uint32 bitCount, AvBitField* bitField){
 void avBitFieldDestroy(AvBitField* bitField){
     avAssert(bitField!=nullptr, "bitField must be a valid pointer");
     avAssert(bitField->bitCount>0, "bitfield cannot have a size of 0");
-    avFree(bitField->bits);
+    avFree(bitField->words);
     memset(bitField, 0, sizeof(AvBitField));
 }
 
@@ -32,14 +50,18 @@ bool8 avBitFieldTest(uint32 bit, AvBitField bitField){
     if(bit >= bitField.bitCount){
         return false;
     }
-    return bitField.bits[bit/8] & (1<<(bit%8));
+    return (bitField.words[WORD_INDEX(bit)] & WORD_MASK(bit)) != 0;
 }
 
 void avBitFieldWrite(uint32 bit, bool8 state, AvBitField bitField){
     if(bit >= bitField.bitCount){
         return;
     }
-    bitField.bits[bit/8] |= (state?1:0)<<(bit%8);
+    if(state){
+        bitField.words[WORD_INDEX(bit)] |= WORD_MASK(bit);
+    }else{
+        bitField.words[WORD_INDEX(bit)] &= ~WORD_MASK(bit);
+    }
 }
 
 void avBitFieldSet(uint32 bit, AvBitField bitField){
@@ -51,32 +73,40 @@ void avBitFieldReset(uint32 bit, AvBitField bitField){
 }
 
 void avBitFieldToggle(uint32 bit, AvBitField bitField){
-    avBitFieldWrite(bit, !avBitFieldTest(bit, bitField), bitField);
+    if(bit >= bitField.bitCount){
+        return;
+    }
+    bitField.words[WORD_INDEX(bit)] ^= WORD_MASK(bit);
 }
 
-static uint8 count_ones (uint8 byte)
-{
-  static const uint8 NIBBLE_LOOKUP [16] =
-  {
-    0, 1, 1, 2, 1, 2, 2, 3, 
-    1, 2, 2, 3, 2, 3, 3, 4
-  };
-
+AV_HOT_KERNEL static uint32 countWords(const uint64* words, uint32 count){
+    uint64 total = 0;
+    for(uint32 i = 0; i < count; i++){
+        total += __builtin_popcountll(words[i]);
+    }
+    return (uint32)total;
+}
 
-  return NIBBLE_LOOKUP[byte & 0x0F] + NIBBLE_LOOKUP[byte >> 4];
+#ifdef AV_BITFIELD_X86_64
+// same loop, but allowed to use the popcnt instruction
+AV_HOT_KERNEL_TARGET("popcnt")
+static uint32 countWordsHardware(const uint64* words, uint32 count){
+    uint64 total = 0;
+    for(uint32 i = 0; i < count; i++){
+        total += __builtin_popcountll(words[i]);
+    }
+    return (uint32)total;
 }
+#endif
 
 uint32 avBitFieldCountOnes(AvBitField bitField){
-    uint32 count = 0;
-    byte remainder = bitField.bitCount % 8;
-    for(uint32 i = 0; i < getByteCount(bitField.bitCount); i++){
-        byte data = bitField.bits[i];
-        if(remainder && i == bitField.bitCount/8){
-            data &= MASK_ONES(remainder);
-        }
-        count+= count_ones(data);
+    uint32 wordCount = getWordCount(bitField.bitCount);
+#ifdef AV_BITFIELD_X86_64
+    if(__builtin_cpu_supports("popcnt")){
+        return countWordsHardware(bitField.words, wordCount);
     }
-    return count;
+#endif
+    return countWords(bitField.words, wordCount);
 }
 
 uint32 avBitFieldCountZeros(AvBitField bitField){
@@ -84,11 +114,131 @@ uint32 avBitFieldCountZeros(AvBitField bitField){
     return count - avBitFieldCountOnes(bitField);
 }
 
-
-
 void avBitFieldWriteAll(bool8 state, AvBitField bitField){
-    memset(bitField.bits, state?(0xff):(0x00), getByteCount(bitField.bitCount));
+    memset(bitField.words, state?(0xff):(0x00), getWordCount(bitField.bitCount) * sizeof(uint64));
     if(state){
-        bitField.bits[getByteCount(bitField.bitCount)] &= MASK_ONES(bitField.bitCount % 8);
+        clearTail(bitField);
+    }
+}
+
+uint32 avBitFieldGetWordCount(AvBitField bitField){
+    return getWordCount(bitField.bitCount);
+}
+
+// invert flips every word so the same scan finds clear bits
+AV_HOT_KERNEL static uint32 findNext(uint32 start, uint64 invert, AvBitField bitField){
+    if(start >= bitField.bitCount){
+        return AV_BITFIELD_NOT_FOUND;
     }
+    uint32 wordCount = getWordCount(bitField.bitCount);
+    uint32 index = WORD_INDEX(start);
+    // drop the bits below start in the first word
+    uint64 word = (bitField.words[index] ^ invert) & (~0ULL << (start % WORD_BITS));
+    while(true){
+        if(index == wordCount - 1){
+            word &= getTailMask(bitField.bitCount);
+        }
+        if(word){
+            return index * WORD_BITS + __builtin_ctzll(word);
+        }
+        if(++index == wordCount){
+            return AV_BITFIELD_NOT_FOUND;
+        }
+        word = bitField.words[index] ^ invert;
+    }
+}
+
+uint32 avBitFieldFindFirstSet(AvBitField bitField){
+    return findNext(0, 0, bitField);
+}
+
+uint32 avBitFieldFindFirstClear(AvBitField bitField){
+    return findNext(0, ~0ULL, bitField);
+}
+
+uint32 avBitFieldFindNextSet(uint32 start, AvBitField bitField){
+    return findNext(start, 0, bitField);
+}
+
+uint32 avBitFieldFindNextClear(uint32 start, AvBitField bitField){
+    return findNext(start, ~0ULL, bitField);
+}
+
+uint32 avBitFieldForEachSet(AvBitFieldCallback callback, void* userData, AvBitField bitField){
+    avAssert(callback!=nullptr, "callback must be a valid function");
+    uint32 wordCount = getWordCount(bitField.bitCount);
+    uint32 visited = 0;
+    for(uint32 i = 0; i < wordCount; i++){
+        uint64 word = bitField.words[i];
+        while(word){
+            uint32 bit = i * WORD_BITS + __builtin_ctzll(word);
+            // clear the lowest set bit
+            word &= word - 1;
+            visited++;
+            if(!callback(bit, userData)){
+                return visited;
+            }
+        }
+    }
+    return visited;
+}
+
+typedef enum BitOperation {
+    BIT_OPERATION_AND,
+    BIT_OPERATION_OR,
+    BIT_OPERATION_XOR,
+    BIT_OPERATION_AND_NOT,
+} BitOperation;
+
+AV_HOT_KERNEL static void combineWords(uint64* dst, const uint64* src, uint32 count, BitOperation operation){
+    uint32 i = 0;
+#ifdef AV_BITFIELD_X86_64
+    for(; i + 2 <= count; i += 2){
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+        switch(operation){
+        case BIT_OPERATION_AND: a = _mm_and_si128(a, b); break;
+        case BIT_OPERATION_OR: a = _mm_or_si128(a, b); break;
+        case BIT_OPERATION_XOR: a = _mm_xor_si128(a, b); break;
+        case BIT_OPERATION_AND_NOT: a = _mm_andnot_si128(b, a); break;
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), a);
+    }
+#endif
+    for(; i < count; i++){
+        switch(operation){
+        case BIT_OPERATION_AND: dst[i] &= src[i]; break;
+        case BIT_OPERATION_OR: dst[i] |= src[i]; break;
+        case BIT_OPERATION_XOR: dst[i] ^= src[i]; break;
+        case BIT_OPERATION_AND_NOT: dst[i] &= ~src[i]; break;
+        }
+    }
+}
+
+static void combine(AvBitField dst, AvBitField src, BitOperation operation){
+    uint32 dstWords = getWordCount(dst.bitCount);
+    uint32 srcWords = getWordCount(src.bitCount);
+    uint32 shared = AV_MIN(dstWords, srcWords);
+    combineWords(dst.words, src.words, shared, operation);
+    if(operation == BIT_OPERATION_AND && dstWords > shared){
+        memset(dst.words + shared, 0, (dstWords - shared) * sizeof(uint64));
+    }
+    // a longer src may carry bits past the end of dst
+    clearTail(dst);
+}
+
+void avBitFieldAnd(AvBitField dst, AvBitField src){
+    combine(dst, src, BIT_OPERATION_AND);
+}
+
+void avBitFieldOr(AvBitField dst, AvBitField src){
+    combine(dst, src, BIT_OPERATION_OR);
+}
+
+void avBitFieldXor(AvBitField dst, AvBitField src){
+    combine(dst, src, BIT_OPERATION_XOR);
+}
+
+void avBitFieldAndNot(AvBitField dst, AvBitField src){
+    combine(dst, src, BIT_OPERATION_AND_NOT);
 }
@@ -0,0 +1,280 @@
+#include <AvUtils/util/avHash.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AV_HASH_X86_64
+#include <immintrin.h>
+#endif
+
+#define HASH_FILE_CHUNK_SIZE (1 << 16)
+#define HASH_INLINE static inline __attribute__((always_inline))
+
+static const uint64 secret[4] = {
+	0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+HASH_INLINE void multiply(uint64* a, uint64* b) {
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)*a * *b;
+	*a = (uint64)r;
+	*b = (uint64)(r >> 64);
+#else
+	uint64 ha = *a >> 32, hb = *b >> 32, la = (uint32)*a, lb = (uint32)*b;
+	uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64 t = rl + (rm0 << 32);
+	uint64 c = t < rl;
+	uint64 lo = t + (rm1 << 32);
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+HASH_INLINE uint64 mix(uint64 a, uint64 b) {
+	multiply(&a, &b);
+	return a ^ b;
+}
+
+HASH_INLINE uint64 read8(const byte* p) {
+	uint64 value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+HASH_INLINE uint64 read4(const byte* p) {
+	uint32 value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+HASH_INLINE uint64 read3(const byte* p, uint64 size) {
+	return (((uint64)p[0]) << 16) | (((uint64)p[size >> 1]) << 8) | p[size - 1];
+}
+
+HASH_INLINE uint64 mixSeed(uint64 seed) {
+	return seed ^ mix(seed ^ secret[0], secret[1]);
+}
+
+HASH_INLINE uint64 finalMix(uint64 a, uint64 b, uint64 seed, uint64 length) {
+	a ^= secret[1];
+	b ^= seed;
+	multiply(&a, &b);
+	return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+HASH_INLINE void processBlock(const byte* p, uint64* seed, uint64* see1, uint64* see2) {
+	*seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ *seed);
+	*see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ *see1);
+	*see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ *see2);
+}
+
+// hashes the trailing (at most 48) bytes, may read up to 16 bytes before p when blocks were processed
+HASH_INLINE uint64 finish(const byte* p, uint64 remaining, uint64 seed, uint64 length) {
+	while (remaining > 16) {
+		seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+		remaining -= 16;
+		p += 16;
+	}
+	return finalMix(read8(p + remaining - 16), read8(p + remaining - 8), seed, length);
+}
+
+HASH_INLINE uint64 hashShort(const byte* p, uint64 length, uint64 seed) {
+	uint64 a = 0;
+	uint64 b = 0;
+	if (length >= 4) {
+		a = (read4(p) << 32) | read4(p + ((length >> 3) << 2));
+		b = (read4(p + length - 4) << 32) | read4(p + length - 4 - ((length >> 3) << 2));
+	} else if (length > 0) {
+		a = read3(p, length);
+	}
+	return finalMix(a, b, seed, length);
+}
+
+AV_HOT_KERNEL
+uint64 avHash64(const void* data, uint64 size, uint64 seed) {
+	const byte* p = (const byte*)data;
+	seed = mixSeed(seed);
+	if (size <= 16) {
+		return hashShort(p, size, seed);
+	}
+	uint64 remaining = size;
+	if (remaining > AV_HASH_STATE_BLOCK_SIZE) {
+		uint64 see1 = seed;
+		uint64 see2 = seed;
+		do {
+			processBlock(p, &seed, &see1, &see2);
+			p += AV_HASH_STATE_BLOCK_SIZE;
+			remaining -= AV_HASH_STATE_BLOCK_SIZE;
+		} while (remaining > AV_HASH_STATE_BLOCK_SIZE);
+		seed ^= see1 ^ see2;
+	}
+	return finish(p, remaining, seed, size);
+}
+
+AV_HOT_KERNEL
+uint64 avHashU64(uint64 value) {
+	return mix(value ^ secret[0], secret[1] ^ (value >> 32));
+}
+
+void avHashStateInit(uint64 seed, AvHashState* state) {
+	avAssert(state != nullptr, "state must be a valid reference");
+	memset(state, 0, sizeof(AvHashState));
+	state->seed = mixSeed(seed);
+	state->see1 = state->seed;
+	state->see2 = state->seed;
+}
+
+AV_HOT_KERNEL
+static void stateProcessBlock(const byte* p, AvHashState* state) {
+	processBlock(p, &state->seed, &state->see1, &state->see2);
+	memcpy(state->buffer, p + AV_HASH_STATE_BLOCK_SIZE - AV_HASH_STATE_HISTORY_SIZE, AV_HASH_STATE_HISTORY_SIZE);
+	state->blocksProcessed = true;
+}
+
+AV_HOT_KERNEL
+void avHashStateUpdate(const void* data, uint64 size, AvHashState* state) {
+	avAssert(state != nullptr, "state must be a valid reference");
+	const byte* p = (const byte*)data;
+	byte* pending = state->buffer + AV_HASH_STATE_HISTORY_SIZE;
+	state->totalLength += size;
+
+	// a block may only be consumed once it is known not to contain the final bytes
+	if (state->bufferLength && state->bufferLength + size > AV_HASH_STATE_BLOCK_SIZE) {
+		uint64 fill = AV_HASH_STATE_BLOCK_SIZE - state->bufferLength;
+		memcpy(pending + state->bufferLength, p, fill);
+		p += fill;
+		size -= fill;
+		state->bufferLength = 0;
+		stateProcessBlock(pending, state);
+	}
+	while (size > AV_HASH_STATE_BLOCK_SIZE) {
+		stateProcessBlock(p, state);
+		p += AV_HASH_STATE_BLOCK_SIZE;
+		size -= AV_HASH_STATE_BLOCK_SIZE;
+	}
+	memcpy(pending + state->bufferLength, p, size);
+	state->bufferLength += size;
+}
+
+AV_HOT_KERNEL
+uint64 avHashStateFinal(const AvHashState* state) {
+	avAssert(state != nullptr, "state must be a valid reference");
+	const byte* pending = state->buffer + AV_HASH_STATE_HISTORY_SIZE;
+	if (!state->blocksProcessed) {
+		if (state->totalLength <= 16) {
+			return hashShort(pending, state->totalLength, state->seed);
+		}
+		return finish(pending, state->bufferLength, state->seed, state->totalLength);
+	}
+	uint64 seed = state->seed ^ state->see1 ^ state->see2;
+	return finish(pending, state->bufferLength, seed, state->totalLength);
+}
+
+bool32 avHashFile(AvFile file, uint64 seed, uint64* hash) {
+	avAssert(file != nullptr, "file must be a valid handle");
+	avAssert(hash != nullptr, "hash must be a valid reference");
+
+	bool32 opened = false;
+	if ((avFileGetStatus(file) & (AV_FILE_STATUS_OPEN_READ | AV_FILE_STATUS_OPEN_UPDATE)) == 0) {
+		if (!avFileOpen(file, AV_FILE_OPEN_READ_BINARY_DEFAULT)) {
+			return false;
+		}
+		opened = true;
+	}
+
+	AvHashState state;
+	avHashStateInit(seed, &state);
+	byte* buffer = avAllocate(HASH_FILE_CHUNK_SIZE, "allocating file hash buffer");
+	uint64 read = 0;
+	while ((read = avFileRead(buffer, HASH_FILE_CHUNK_SIZE, file)) != 0) {
+		avHashStateUpdate(buffer, read, &state);
+	}
+	avFree(buffer);
+
+	if (opened) {
+		avFileClose(file);
+	}
+	*hash = avHashStateFinal(&state);
+	return true;
+}
+
+static const uint32 crc32cTable[256] = {
+	0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+	0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+	0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+	0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+	0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+	0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+	0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+	0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+	0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+	0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+	0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+	0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+	0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+	0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+	0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+	0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+	0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+	0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+	0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+	0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+	0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+	0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+	0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+	0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+	0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+	0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+	0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+	0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+	0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+	0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+	0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+	0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351,
+};
+
+AV_HOT_KERNEL
+static uint32 crc32cSoftware(const byte* p, uint64 size, uint32 crc) {
+	while (size--) {
+		crc = crc32cTable[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+#ifdef AV_HASH_X86_64
+AV_HOT_KERNEL_TARGET("sse4.2")
+static uint32 crc32cHardware(const byte* p, uint64 size, uint32 crc) {
+	while (size && ((uint64)p & 7)) {
+		crc = _mm_crc32_u8(crc, *p++);
+		size--;
+	}
+	uint64 crc64 = crc;
+	while (size >= 8) {
+		crc64 = _mm_crc32_u64(crc64, read8(p));
+		p += 8;
+		size -= 8;
+	}
+	crc = (uint32)crc64;
+	while (size--) {
+		crc = _mm_crc32_u8(crc, *p++);
+	}
+	return crc;
+}
+#endif
+
+uint32 avCrc32c(const void* data, uint64 size, uint32 crc) {
+	const byte* p = (const byte*)data;
+	crc = ~crc;
+#ifdef AV_HASH_X86_64
+	if (__builtin_cpu_supports("sse4.2")) {
+		return ~crc32cHardware(p, size, crc);
+	}
+#endif
+	return ~crc32cSoftware(p, size, crc);
+}
+
+uint64 avStringHash(AvString str) {
+	return avHash64(str.chrs, str.len, AV_HASH_DEFAULT_SEED);
+}
@@ -6,5 +6,5 @@ uint32 nextPow2(uint32 x) {
 }
 
 uint64 nextPow2L(uint64 x){
-	return x == 1 ? 1ULL : 1ULL<<(64U-__builtin_clz(x-1U)); 
+	return x == 1 ? 1ULL : 1ULL<<(64U-__builtin_clzll(x-1U)); 
 }
\ No newline at end of file
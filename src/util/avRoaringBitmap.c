@@ -0,0 +1,969 @@
+#include <AvUtils/util/avRoaringBitmap.h>
+#include <AvUtils/avMemory.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/avLogging.h>
+#include <string.h>
+
+#define CHUNK_BITS 16
+#define CHUNK_MASK 0xFFFF
+// an array holding more values than this is larger than a bitmap
+#define ARRAY_MAX 4096
+#define BITMAP_WORDS 1024
+#define RUN_MAX 32768
+#define SERIALIZE_MAGIC 0x42525641
+
+typedef enum ContainerType {
+	CONTAINER_ARRAY,
+	CONTAINER_BITMAP,
+	CONTAINER_RUN,
+} ContainerType;
+
+// covers the values start to start + length, both inclusive
+typedef struct Run {
+	uint16 start;
+	uint16 length;
+} Run;
+
+typedef struct Container {
+	uint16 key;
+	uint8 type;
+	// number of values in the chunk, never 0 for a stored container
+	uint32 cardinality;
+	// values of an array container or runs of a run container
+	uint32 count;
+	uint32 capacity;
+	void* data;
+} Container;
+
+// containers are sorted on their key
+typedef struct AvRoaringBitmap_T {
+	Container* containers;
+	uint32 count;
+	uint32 capacity;
+	uint64 cardinality;
+} AvRoaringBitmap_T;
+
+typedef enum SetOperation {
+	SET_OPERATION_AND,
+	SET_OPERATION_OR,
+	SET_OPERATION_XOR,
+	SET_OPERATION_AND_NOT,
+} SetOperation;
+
+static uint32 lowerBound(const uint16* values, uint32 count, uint16 value) {
+	uint32 low = 0;
+	uint32 high = count;
+	while (low < high) {
+		uint32 middle = (low + high) / 2;
+		if (values[middle] < value) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+// index of the last run starting at or before value, count if there is none
+static uint32 findRun(const Run* runs, uint32 count, uint16 value) {
+	uint32 low = 0;
+	uint32 high = count;
+	while (low < high) {
+		uint32 middle = (low + high) / 2;
+		if (runs[middle].start <= value) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low == 0 ? count : low - 1;
+}
+
+static void setRange(uint64* words, uint32 first, uint32 last) {
+	uint32 firstWord = first / 64;
+	uint32 lastWord = last / 64;
+	uint64 firstMask = ~0ULL << (first % 64);
+	uint64 lastMask = ~0ULL >> (63 - last % 64);
+	if (firstWord == lastWord) {
+		words[firstWord] |= firstMask & lastMask;
+		return;
+	}
+	words[firstWord] |= firstMask;
+	for (uint32 i = firstWord + 1; i < lastWord; i++) {
+		words[i] = ~0ULL;
+	}
+	words[lastWord] |= lastMask;
+}
+
+AV_HOT_KERNEL static uint32 countWords(const uint64* words) {
+	uint32 count = 0;
+	for (uint32 i = 0; i < BITMAP_WORDS; i++) {
+		count += __builtin_popcountll(words[i]);
+	}
+	return count;
+}
+
+AV_HOT_KERNEL static void combineWords(uint64* dst, const uint64* src, SetOperation operation) {
+	for (uint32 i = 0; i < BITMAP_WORDS; i++) {
+		switch (operation) {
+		case SET_OPERATION_AND: dst[i] &= src[i]; break;
+		case SET_OPERATION_OR: dst[i] |= src[i]; break;
+		case SET_OPERATION_XOR: dst[i] ^= src[i]; break;
+		case SET_OPERATION_AND_NOT: dst[i] &= ~src[i]; break;
+		}
+	}
+}
+
+// number of runs in a bitmap, every set bit whose lower neighbour is clear starts a run
+AV_HOT_KERNEL static uint32 countBitmapRuns(const uint64* words) {
+	uint32 runs = 0;
+	uint64 carry = 0;
+	for (uint32 i = 0; i < BITMAP_WORDS; i++) {
+		runs += __builtin_popcountll(words[i] & ~((words[i] << 1) | carry));
+		carry = words[i] >> 63;
+	}
+	return runs;
+}
+
+// writes the values of a container into a zeroed bitmap
+static void fillBitmap(uint64* words, const Container* container) {
+	switch (container->type) {
+	case CONTAINER_ARRAY: {
+		const uint16* values = container->data;
+		for (uint32 i = 0; i < container->count; i++) {
+			words[values[i] / 64] |= 1ULL << (values[i] % 64);
+		}
+		break;
+	}
+	case CONTAINER_BITMAP:
+		memcpy(words, container->data, BITMAP_WORDS * sizeof(uint64));
+		break;
+	case CONTAINER_RUN: {
+		const Run* runs = container->data;
+		for (uint32 i = 0; i < container->count; i++) {
+			setRange(words, runs[i].start, runs[i].start + runs[i].length);
+		}
+		break;
+	}
+	}
+}
+
+static void replaceData(Container* container, ContainerType type, void* data, uint32 count, uint32 capacity) {
+	avFree(container->data);
+	container->type = type;
+	container->data = data;
+	container->count = count;
+	container->capacity = capacity;
+}
+
+static void toBitmap(Container* container) {
+	if (container->type == CONTAINER_BITMAP) {
+		return;
+	}
+	uint64* words = avCallocate(BITMAP_WORDS, sizeof(uint64), "allocating roaring bitmap container");
+	fillBitmap(words, container);
+	replaceData(container, CONTAINER_BITMAP, words, 0, BITMAP_WORDS);
+}
+
+// only valid for containers that hold at most ARRAY_MAX values
+static void toArray(Container* container) {
+	if (container->type == CONTAINER_ARRAY) {
+		return;
+	}
+	uint32 capacity = AV_MAX(container->cardinality, 4);
+	uint16* values = avAllocate(sizeof(uint16) * capacity, "allocating roaring array container");
+	uint32 count = 0;
+	if (container->type == CONTAINER_BITMAP) {
+		const uint64* words = container->data;
+		for (uint32 i = 0; i < BITMAP_WORDS; i++) {
+			uint64 word = words[i];
+			while (word) {
+				values[count++] = (uint16)(i * 64 + __builtin_ctzll(word));
+				word &= word - 1;
+			}
+		}
+	} else {
+		const Run* runs = container->data;
+		for (uint32 i = 0; i < container->count; i++) {
+			for (uint32 value = runs[i].start; value <= (uint32)runs[i].start + runs[i].length; value++) {
+				values[count++] = (uint16)value;
+			}
+		}
+	}
+	replaceData(container, CONTAINER_ARRAY, values, count, capacity);
+}
+
+static void toRuns(Container* container, uint32 runCount) {
+	Run* runs = avAllocate(sizeof(Run) * AV_MAX(runCount, 1), "allocating roaring run container");
+	uint32 count = 0;
+	if (container->type == CONTAINER_ARRAY) {
+		const uint16* values = container->data;
+		for (uint32 i = 0; i < container->count; i++) {
+			if (count && (uint32)runs[count - 1].start + runs[count - 1].length + 1 == values[i]) {
+				runs[count - 1].length++;
+			} else {
+				runs[count++] = (Run){ .start = values[i], .length = 0 };
+			}
+		}
+	} else {
+		const uint64* words = container->data;
+		uint32 value = 0;
+		while (value < (1 << CHUNK_BITS)) {
+			uint64 word = words[value / 64] >> (value % 64);
+			if (word == 0) {
+				value = (value / 64 + 1) * 64;
+				continue;
+			}
+			value += __builtin_ctzll(word);
+			// find the end of the run
+			uint32 end = value;
+			while (end + 1 < (1 << CHUNK_BITS) && (words[(end + 1) / 64] >> ((end + 1) % 64)) & 1) {
+				uint64 rest = ~words[(end + 1) / 64] >> ((end + 1) % 64);
+				end += rest ? (uint32)__builtin_ctzll(rest) : 64 - (end + 1) % 64;
+			}
+			runs[count++] = (Run){ .start = (uint16)value, .length = (uint16)(end - value) };
+			value = end + 1;
+		}
+	}
+	replaceData(container, CONTAINER_RUN, runs, count, AV_MAX(runCount, 1));
+}
+
+// picks array or bitmap storage for a container after its contents changed
+static void normalize(Container* container) {
+	if (container->type == CONTAINER_BITMAP && container->cardinality <= ARRAY_MAX && container->cardinality) {
+		toArray(container);
+	} else if (container->type == CONTAINER_ARRAY && container->cardinality > ARRAY_MAX) {
+		toBitmap(container);
+	}
+}
+
+static bool32 containerContains(const Container* container, uint16 value) {
+	switch (container->type) {
+	case CONTAINER_ARRAY: {
+		const uint16* values = container->data;
+		uint32 index = lowerBound(values, container->count, value);
+		return index < container->count && values[index] == value;
+	}
+	case CONTAINER_BITMAP:
+		return (((const uint64*)container->data)[value / 64] >> (value % 64)) & 1;
+	case CONTAINER_RUN: {
+		const Run* runs = container->data;
+		uint32 index = findRun(runs, container->count, value);
+		return index < container->count && value <= (uint32)runs[index].start + runs[index].length;
+	}
+	}
+	return false;
+}
+
+static bool32 containerAdd(Container* container, uint16 value) {
+	if (container->type == CONTAINER_RUN) {
+		// run lists are not edited in place, avRoaringBitmapRunOptimize brings them back
+		if (containerContains(container, value)) {
+			return false;
+		}
+		if (container->cardinality < ARRAY_MAX) {
+			toArray(container);
+		} else {
+			toBitmap(container);
+		}
+	}
+	if (container->type == CONTAINER_ARRAY) {
+		uint16* values = container->data;
+		uint32 index = lowerBound(values, container->count, value);
+		if (index < container->count && values[index] == value) {
+			return false;
+		}
+		if (container->count == ARRAY_MAX) {
+			toBitmap(container);
+		} else {
+			if (container->count == container->capacity) {
+				container->capacity = AV_MIN(container->capacity * 2, ARRAY_MAX);
+				container->data = avReallocate(container->data, sizeof(uint16) * container->capacity, "resizing roaring array container");
+				values = container->data;
+			}
+			memmove(values + index + 1, values + index, sizeof(uint16) * (container->count - index));
+			values[index] = value;
+			container->count++;
+			container->cardinality++;
+			return true;
+		}
+	}
+	uint64* words = container->data;
+	uint64 mask = 1ULL << (value % 64);
+	if (words[value / 64] & mask) {
+		return false;
+	}
+	words[value / 64] |= mask;
+	container->cardinality++;
+	return true;
+}
+
+static bool32 containerRemove(Container* container, uint16 value) {
+	if (container->type == CONTAINER_RUN) {
+		if (!containerContains(container, value)) {
+			return false;
+		}
+		if (container->cardinality <= ARRAY_MAX) {
+			toArray(container);
+		} else {
+			toBitmap(container);
+		}
+	}
+	if (container->type == CONTAINER_ARRAY) {
+		uint16* values = container->data;
+		uint32 index = lowerBound(values, container->count, value);
+		if (index == container->count || values[index] != value) {
+			return false;
+		}
+		memmove(values + index, values + index + 1, sizeof(uint16) * (container->count - index - 1));
+		container->count--;
+		container->cardinality--;
+		return true;
+	}
+	uint64* words = container->data;
+	uint64 mask = 1ULL << (value % 64);
+	if (!(words[value / 64] & mask)) {
+		return false;
+	}
+	words[value / 64] &= ~mask;
+	container->cardinality--;
+	normalize(container);
+	return true;
+}
+
+static void containerClone(const Container* src, Container* dst) {
+	*dst = *src;
+	uint64 size;
+	switch (src->type) {
+	case CONTAINER_ARRAY: size = sizeof(uint16) * src->capacity; break;
+	case CONTAINER_BITMAP: size = sizeof(uint64) * BITMAP_WORDS; break;
+	default: size = sizeof(Run) * src->capacity; break;
+	}
+	dst->data = avAllocate(size, "allocating roaring bitmap container");
+	memcpy(dst->data, src->data, size);
+}
+
+// merges two sorted arrays
+static void arrayCombine(Container* dst, const Container* src, SetOperation operation) {
+	const uint16* a = dst->data;
+	const uint16* b = src->data;
+	uint32 countA = dst->count;
+	uint32 countB = src->count;
+	bool32 keepA = operation != SET_OPERATION_AND;
+	bool32 keepB = operation == SET_OPERATION_OR || operation == SET_OPERATION_XOR;
+	bool32 keepBoth = operation == SET_OPERATION_AND || operation == SET_OPERATION_OR;
+	uint32 capacity = AV_MAX(keepB ? countA + countB : countA, 4);
+	uint16* values = avAllocate(sizeof(uint16) * capacity, "allocating roaring array container");
+	uint32 count = 0;
+	uint32 i = 0;
+	uint32 j = 0;
+	while (i < countA && j < countB) {
+		if (a[i] < b[j]) {
+			if (keepA) {
+				values[count++] = a[i];
+			}
+			i++;
+		} else if (a[i] > b[j]) {
+			if (keepB) {
+				values[count++] = b[j];
+			}
+			j++;
+		} else {
+			if (keepBoth) {
+				values[count++] = a[i];
+			}
+			i++;
+			j++;
+		}
+	}
+	while (keepA && i < countA) {
+		values[count++] = a[i++];
+	}
+	while (keepB && j < countB) {
+		values[count++] = b[j++];
+	}
+	replaceData(dst, CONTAINER_ARRAY, values, count, capacity);
+	dst->cardinality = count;
+	normalize(dst);
+}
+
+static void containerCombine(Container* dst, const Container* src, SetOperation operation) {
+	if (dst->type == CONTAINER_ARRAY && src->type == CONTAINER_ARRAY) {
+		arrayCombine(dst, src, operation);
+		return;
+	}
+	if (dst->type == CONTAINER_ARRAY && (operation == SET_OPERATION_AND || operation == SET_OPERATION_AND_NOT)) {
+		// the result is a subset of dst, filter it in place
+		uint16* values = dst->data;
+		uint32 count = 0;
+		for (uint32 i = 0; i < dst->count; i++) {
+			if (containerContains(src, values[i]) == (operation == SET_OPERATION_AND)) {
+				values[count++] = values[i];
+			}
+		}
+		dst->count = count;
+		dst->cardinality = count;
+		return;
+	}
+	toBitmap(dst);
+	if (src->type == CONTAINER_BITMAP) {
+		combineWords(dst->data, src->data, operation);
+	} else {
+		uint64 words[BITMAP_WORDS] = { 0 };
+		fillBitmap(words, src);
+		combineWords(dst->data, words, operation);
+	}
+	dst->cardinality = countWords(dst->data);
+	normalize(dst);
+}
+
+static void containerFree(Container* container) {
+	avFree(container->data);
+}
+
+static uint64 containerBytes(const Container* container) {
+	switch (container->type) {
+	case CONTAINER_ARRAY: return sizeof(uint16) * container->capacity;
+	case CONTAINER_BITMAP: return sizeof(uint64) * BITMAP_WORDS;
+	default: return sizeof(Run) * container->capacity;
+	}
+}
+
+// index of the first container with a key not less than key
+static uint32 findContainer(uint16 key, AvRoaringBitmap bitmap) {
+	uint32 low = 0;
+	uint32 high = bitmap->count;
+	while (low < high) {
+		uint32 middle = (low + high) / 2;
+		if (bitmap->containers[middle].key < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+static Container* getContainer(uint16 key, AvRoaringBitmap bitmap) {
+	uint32 index = findContainer(key, bitmap);
+	if (index < bitmap->count && bitmap->containers[index].key == key) {
+		return bitmap->containers + index;
+	}
+	return nullptr;
+}
+
+// inserts an empty array container
+static Container* insertContainer(uint32 index, uint16 key, AvRoaringBitmap bitmap) {
+	if (bitmap->count == bitmap->capacity) {
+		bitmap->capacity = AV_MAX(bitmap->capacity * 2, 4);
+		bitmap->containers = avReallocate(bitmap->containers, sizeof(Container) * bitmap->capacity, "resizing roaring bitmap containers");
+	}
+	memmove(bitmap->containers + index + 1, bitmap->containers + index, sizeof(Container) * (bitmap->count - index));
+	bitmap->count++;
+	Container* container = bitmap->containers + index;
+	*container = (Container){
+		.key = key,
+		.type = CONTAINER_ARRAY,
+		.capacity = 4,
+		.data = avAllocate(sizeof(uint16) * 4, "allocating roaring array container"),
+	};
+	return container;
+}
+
+static void removeContainer(uint32 index, AvRoaringBitmap bitmap) {
+	containerFree(bitmap->containers + index);
+	bitmap->count--;
+	memmove(bitmap->containers + index, bitmap->containers + index + 1, sizeof(Container) * (bitmap->count - index));
+}
+
+void avRoaringBitmapCreate(AvRoaringBitmap* bitmap) {
+	avAssert(bitmap != nullptr, "bitmap must be a valid reference");
+	(*bitmap) = avCallocate(1, sizeof(AvRoaringBitmap_T), "allocating roaring bitmap handle");
+}
+
+void avRoaringBitmapDestroy(AvRoaringBitmap bitmap) {
+	avRoaringBitmapClear(bitmap);
+	if (bitmap->containers) {
+		avFree(bitmap->containers);
+	}
+	avFree(bitmap);
+}
+
+void avRoaringBitmapClone(AvRoaringBitmap src, AvRoaringBitmap* dst) {
+	avRoaringBitmapCreate(dst);
+	if (src->count == 0) {
+		return;
+	}
+	(*dst)->containers = avAllocate(sizeof(Container) * src->count, "allocating roaring bitmap containers");
+	(*dst)->capacity = src->count;
+	(*dst)->count = src->count;
+	(*dst)->cardinality = src->cardinality;
+	for (uint32 i = 0; i < src->count; i++) {
+		containerClone(src->containers + i, (*dst)->containers + i);
+	}
+}
+
+void avRoaringBitmapClear(AvRoaringBitmap bitmap) {
+	for (uint32 i = 0; i < bitmap->count; i++) {
+		containerFree(bitmap->containers + i);
+	}
+	bitmap->count = 0;
+	bitmap->cardinality = 0;
+}
+
+bool32 avRoaringBitmapAdd(uint32 value, AvRoaringBitmap bitmap) {
+	uint16 key = (uint16)(value >> CHUNK_BITS);
+	uint32 index = findContainer(key, bitmap);
+	Container* container;
+	if (index < bitmap->count && bitmap->containers[index].key == key) {
+		container = bitmap->containers + index;
+	} else {
+		container = insertContainer(index, key, bitmap);
+	}
+	if (!containerAdd(container, (uint16)(value & CHUNK_MASK))) {
+		return false;
+	}
+	bitmap->cardinality++;
+	return true;
+}
+
+bool32 avRoaringBitmapRemove(uint32 value, AvRoaringBitmap bitmap) {
+	uint16 key = (uint16)(value >> CHUNK_BITS);
+	uint32 index = findContainer(key, bitmap);
+	if (index == bitmap->count || bitmap->containers[index].key != key) {
+		return false;
+	}
+	if (!containerRemove(bitmap->containers + index, (uint16)(value & CHUNK_MASK))) {
+		return false;
+	}
+	if (bitmap->containers[index].cardinality == 0) {
+		removeContainer(index, bitmap);
+	}
+	bitmap->cardinality--;
+	return true;
+}
+
+bool32 avRoaringBitmapContains(uint32 value, AvRoaringBitmap bitmap) {
+	Container* container = getContainer((uint16)(value >> CHUNK_BITS), bitmap);
+	return container && containerContains(container, (uint16)(value & CHUNK_MASK));
+}
+
+void avRoaringBitmapAddRange(uint32 first, uint32 last, AvRoaringBitmap bitmap) {
+	if (first > last) {
+		return;
+	}
+	for (uint32 key = first >> CHUNK_BITS; key <= last >> CHUNK_BITS; key++) {
+		uint32 low = key == first >> CHUNK_BITS ? first & CHUNK_MASK : 0;
+		uint32 high = key == last >> CHUNK_BITS ? last & CHUNK_MASK : CHUNK_MASK;
+		uint32 index = findContainer((uint16)key, bitmap);
+		Container* container = bitmap->containers + index;
+		if (index == bitmap->count || container->key != key) {
+			container = insertContainer(index, (uint16)key, bitmap);
+		} else if (low != 0 || high != CHUNK_MASK) {
+			bitmap->cardinality -= container->cardinality;
+			toBitmap(container);
+			setRange(container->data, low, high);
+			container->cardinality = countWords(container->data);
+			bitmap->cardinality += container->cardinality;
+			normalize(container);
+			continue;
+		} else {
+			bitmap->cardinality -= container->cardinality;
+		}
+		// a new or completely covered chunk becomes a single run
+		Run* run = avAllocate(sizeof(Run), "allocating roaring run container");
+		*run = (Run){ .start = (uint16)low, .length = (uint16)(high - low) };
+		replaceData(container, CONTAINER_RUN, run, 1, 1);
+		container->cardinality = high - low + 1;
+		bitmap->cardinality += container->cardinality;
+	}
+}
+
+uint64 avRoaringBitmapGetCardinality(AvRoaringBitmap bitmap) {
+	return bitmap->cardinality;
+}
+
+bool32 avRoaringBitmapGetMinimum(uint32* value, AvRoaringBitmap bitmap) {
+	if (bitmap->count == 0) {
+		return false;
+	}
+	const Container* container = bitmap->containers;
+	uint32 low = 0;
+	switch (container->type) {
+	case CONTAINER_ARRAY:
+		low = ((const uint16*)container->data)[0];
+		break;
+	case CONTAINER_BITMAP: {
+		const uint64* words = container->data;
+		uint32 i = 0;
+		while (words[i] == 0) {
+			i++;
+		}
+		low = i * 64 + __builtin_ctzll(words[i]);
+		break;
+	}
+	case CONTAINER_RUN:
+		low = ((const Run*)container->data)[0].start;
+		break;
+	}
+	*value = ((uint32)container->key << CHUNK_BITS) | low;
+	return true;
+}
+
+bool32 avRoaringBitmapGetMaximum(uint32* value, AvRoaringBitmap bitmap) {
+	if (bitmap->count == 0) {
+		return false;
+	}
+	const Container* container = bitmap->containers + bitmap->count - 1;
+	uint32 high = 0;
+	switch (container->type) {
+	case CONTAINER_ARRAY:
+		high = ((const uint16*)container->data)[container->count - 1];
+		break;
+	case CONTAINER_BITMAP: {
+		const uint64* words = container->data;
+		uint32 i = BITMAP_WORDS - 1;
+		while (words[i] == 0) {
+			i--;
+		}
+		high = i * 64 + 63 - __builtin_clzll(words[i]);
+		break;
+	}
+	case CONTAINER_RUN: {
+		const Run* run = (const Run*)container->data + container->count - 1;
+		high = (uint32)run->start + run->length;
+		break;
+	}
+	}
+	*value = ((uint32)container->key << CHUNK_BITS) | high;
+	return true;
+}
+
+uint64 avRoaringBitmapForEach(AvRoaringBitmapCallback callback, void* userData, AvRoaringBitmap bitmap) {
+	avAssert(callback != nullptr, "callback must be a valid function");
+	uint64 visited = 0;
+	for (uint32 c = 0; c < bitmap->count; c++) {
+		const Container* container = bitmap->containers + c;
+		uint32 base = (uint32)container->key << CHUNK_BITS;
+		switch (container->type) {
+		case CONTAINER_ARRAY: {
+			const uint16* values = container->data;
+			for (uint32 i = 0; i < container->count; i++) {
+				visited++;
+				if (!callback(base | values[i], userData)) {
+					return visited;
+				}
+			}
+			break;
+		}
+		case CONTAINER_BITMAP: {
+			const uint64* words = container->data;
+			for (uint32 i = 0; i < BITMAP_WORDS; i++) {
+				uint64 word = words[i];
+				while (word) {
+					visited++;
+					if (!callback(base | (i * 64 + __builtin_ctzll(word)), userData)) {
+						return visited;
+					}
+					word &= word - 1;
+				}
+			}
+			break;
+		}
+		case CONTAINER_RUN: {
+			const Run* runs = container->data;
+			for (uint32 i = 0; i < container->count; i++) {
+				for (uint32 value = runs[i].start; value <= (uint32)runs[i].start + runs[i].length; value++) {
+					visited++;
+					if (!callback(base | value, userData)) {
+						return visited;
+					}
+				}
+			}
+			break;
+		}
+		}
+	}
+	return visited;
+}
+
+// merges the sorted container lists into a new list
+static void combine(AvRoaringBitmap dst, AvRoaringBitmap src, SetOperation operation) {
+	avAssert(dst != src, "dst and src must be different bitmaps");
+	bool32 keepSrc = operation == SET_OPERATION_OR || operation == SET_OPERATION_XOR;
+	uint32 capacity = AV_MAX(dst->count + (keepSrc ? src->count : 0), 4);
+	Container* containers = avAllocate(sizeof(Container) * capacity, "allocating roaring bitmap containers");
+	uint32 count = 0;
+	uint64 cardinality = 0;
+	uint32 i = 0;
+	uint32 j = 0;
+	while (i < dst->count || j < src->count) {
+		if (j == src->count || (i < dst->count && dst->containers[i].key < src->containers[j].key)) {
+			if (operation == SET_OPERATION_AND) {
+				containerFree(dst->containers + i);
+			} else {
+				containers[count++] = dst->containers[i];
+			}
+			i++;
+		} else if (i == dst->count || src->containers[j].key < dst->containers[i].key) {
+			if (keepSrc) {
+				containerClone(src->containers + j, containers + count++);
+			}
+			j++;
+		} else {
+			Container container = dst->containers[i];
+			containerCombine(&container, src->containers + j, operation);
+			if (container.cardinality) {
+				containers[count++] = container;
+			} else {
+				containerFree(&container);
+			}
+			i++;
+			j++;
+		}
+	}
+	for (uint32 c = 0; c < count; c++) {
+		cardinality += containers[c].cardinality;
+	}
+	if (dst->containers) {
+		avFree(dst->containers);
+	}
+	dst->containers = containers;
+	dst->count = count;
+	dst->capacity = capacity;
+	dst->cardinality = cardinality;
+}
+
+void avRoaringBitmapAnd(AvRoaringBitmap dst, AvRoaringBitmap src) {
+	combine(dst, src, SET_OPERATION_AND);
+}
+
+void avRoaringBitmapOr(AvRoaringBitmap dst, AvRoaringBitmap src) {
+	combine(dst, src, SET_OPERATION_OR);
+}
+
+void avRoaringBitmapXor(AvRoaringBitmap dst, AvRoaringBitmap src) {
+	combine(dst, src, SET_OPERATION_XOR);
+}
+
+void avRoaringBitmapAndNot(AvRoaringBitmap dst, AvRoaringBitmap src) {
+	combine(dst, src, SET_OPERATION_AND_NOT);
+}
+
+bool32 avRoaringBitmapEquals(AvRoaringBitmap a, AvRoaringBitmap b) {
+	if (a->cardinality != b->cardinality || a->count != b->count) {
+		return false;
+	}
+	for (uint32 i = 0; i < a->count; i++) {
+		const Container* containerA = a->containers + i;
+		const Container* containerB = b->containers + i;
+		if (containerA->key != containerB->key || containerA->cardinality != containerB->cardinality) {
+			return false;
+		}
+		if (containerA->type == containerB->type && containerA->type != CONTAINER_BITMAP) {
+			uint64 size = containerA->type == CONTAINER_ARRAY ? sizeof(uint16) : sizeof(Run);
+			if (containerA->count != containerB->count || memcmp(containerA->data, containerB->data, size * containerA->count) != 0) {
+				return false;
+			}
+			continue;
+		}
+		uint64 wordsA[BITMAP_WORDS] = { 0 };
+		uint64 wordsB[BITMAP_WORDS] = { 0 };
+		fillBitmap(wordsA, containerA);
+		fillBitmap(wordsB, containerB);
+		if (memcmp(wordsA, wordsB, sizeof(wordsA)) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static uint32 countRuns(const Container* container) {
+	switch (container->type) {
+	case CONTAINER_ARRAY: {
+		const uint16* values = container->data;
+		uint32 runs = container->count ? 1 : 0;
+		for (uint32 i = 1; i < container->count; i++) {
+			runs += values[i] != values[i - 1] + 1;
+		}
+		return runs;
+	}
+	case CONTAINER_BITMAP:
+		return countBitmapRuns(container->data);
+	default:
+		return container->count;
+	}
+}
+
+void avRoaringBitmapRunOptimize(AvRoaringBitmap bitmap) {
+	for (uint32 i = 0; i < bitmap->count; i++) {
+		Container* container = bitmap->containers + i;
+		uint32 runs = countRuns(container);
+		uint64 runBytes = sizeof(Run) * runs;
+		uint64 otherBytes = container->cardinality <= ARRAY_MAX ? sizeof(uint16) * container->cardinality : sizeof(uint64) * BITMAP_WORDS;
+		if (container->type == CONTAINER_RUN) {
+			if (runBytes >= otherBytes) {
+				if (container->cardinality <= ARRAY_MAX) {
+					toArray(container);
+				} else {
+					toBitmap(container);
+				}
+			}
+		} else if (runBytes < otherBytes) {
+			toRuns(container, runs);
+		}
+	}
+}
+
+uint64 avRoaringBitmapGetMemoryUsage(AvRoaringBitmap bitmap) {
+	uint64 size = sizeof(AvRoaringBitmap_T) + sizeof(Container) * bitmap->capacity;
+	for (uint32 i = 0; i < bitmap->count; i++) {
+		size += containerBytes(bitmap->containers + i);
+	}
+	return size;
+}
+
+// serialized layout: magic, container count, then per container key, type, count and the container data
+typedef struct SerializedHeader {
+	uint32 magic;
+	uint32 count;
+} SerializedHeader;
+
+typedef struct SerializedContainer {
+	uint16 key;
+	uint8 type;
+	uint8 reserved;
+	uint32 count;
+} SerializedContainer;
+
+static uint64 serializedDataSize(uint8 type, uint32 count) {
+	switch (type) {
+	case CONTAINER_ARRAY: return sizeof(uint16) * (uint64)count;
+	case CONTAINER_BITMAP: return sizeof(uint64) * BITMAP_WORDS;
+	default: return sizeof(Run) * (uint64)count;
+	}
+}
+
+uint64 avRoaringBitmapGetSerializedSize(AvRoaringBitmap bitmap) {
+	uint64 size = sizeof(SerializedHeader);
+	for (uint32 i = 0; i < bitmap->count; i++) {
+		size += sizeof(SerializedContainer) + serializedDataSize(bitmap->containers[i].type, bitmap->containers[i].count);
+	}
+	return size;
+}
+
+uint64 avRoaringBitmapSerialize(void* buffer, uint64 size, AvRoaringBitmap bitmap) {
+	uint64 required = avRoaringBitmapGetSerializedSize(bitmap);
+	if (buffer == nullptr || size < required) {
+		return 0;
+	}
+	byte* out = buffer;
+	SerializedHeader header = { .magic = SERIALIZE_MAGIC, .count = bitmap->count };
+	memcpy(out, &header, sizeof(header));
+	out += sizeof(header);
+	for (uint32 i = 0; i < bitmap->count; i++) {
+		const Container* container = bitmap->containers + i;
+		SerializedContainer entry = { .key = container->key, .type = container->type, .count = container->count };
+		memcpy(out, &entry, sizeof(entry));
+		out += sizeof(entry);
+		uint64 dataSize = serializedDataSize(container->type, container->count);
+		memcpy(out, container->data, dataSize);
+		out += dataSize;
+	}
+	return required;
+}
+
+// checks the container contents and computes its cardinality
+static bool32 validateContainer(Container* container) {
+	switch (container->type) {
+	case CONTAINER_ARRAY: {
+		const uint16* values = container->data;
+		if (container->count == 0 || container->count > ARRAY_MAX) {
+			return false;
+		}
+		for (uint32 i = 1; i < container->count; i++) {
+			if (values[i] <= values[i - 1]) {
+				return false;
+			}
+		}
+		container->cardinality = container->count;
+		return true;
+	}
+	case CONTAINER_BITMAP:
+		container->cardinality = countWords(container->data);
+		return container->cardinality != 0;
+	case CONTAINER_RUN: {
+		const Run* runs = container->data;
+		if (container->count == 0 || container->count > RUN_MAX) {
+			return false;
+		}
+		uint32 cardinality = 0;
+		for (uint32 i = 0; i < container->count; i++) {
+			if ((uint32)runs[i].start + runs[i].length > CHUNK_MASK) {
+				return false;
+			}
+			if (i && runs[i].start <= (uint32)runs[i - 1].start + runs[i - 1].length) {
+				return false;
+			}
+			cardinality += runs[i].length + 1;
+		}
+		container->cardinality = cardinality;
+		return true;
+	}
+	}
+	return false;
+}
+
+bool32 avRoaringBitmapDeserialize(const void* buffer, uint64 size, AvRoaringBitmap* bitmap) {
+	avAssert(bitmap != nullptr, "bitmap must be a valid reference");
+	const byte* in = buffer;
+	SerializedHeader header;
+	if (buffer == nullptr || size < sizeof(header)) {
+		return false;
+	}
+	memcpy(&header, in, sizeof(header));
+	if (header.magic != SERIALIZE_MAGIC) {
+		return false;
+	}
+	uint64 offset = sizeof(header);
+	AvRoaringBitmap result;
+	avRoaringBitmapCreate(&result);
+	bool32 valid = true;
+	for (uint32 i = 0; i < header.count; i++) {
+		SerializedContainer entry;
+		if (size - offset < sizeof(entry)) {
+			valid = false;
+			break;
+		}
+		memcpy(&entry, in + offset, sizeof(entry));
+		offset += sizeof(entry);
+		if (entry.type > CONTAINER_RUN || (i && entry.key <= result->containers[i - 1].key)) {
+			valid = false;
+			break;
+		}
+		uint64 dataSize = serializedDataSize(entry.type, entry.count);
+		if (size - offset < dataSize) {
+			valid = false;
+			break;
+		}
+		Container* container = insertContainer(i, entry.key, result);
+		replaceData(container, entry.type, avAllocate(AV_MAX(dataSize, 1), "allocating roaring bitmap container"), entry.count, entry.count);
+		if (entry.type == CONTAINER_BITMAP) {
+			container->count = 0;
+			container->capacity = BITMAP_WORDS;
+		}
+		memcpy(container->data, in + offset, dataSize);
+		offset += dataSize;
+		if (!validateContainer(container)) {
+			valid = false;
+			break;
+		}
+		result->cardinality += container->cardinality;
+	}
+	if (!valid || result->count != header.count || offset != size) {
+		avRoaringBitmapDestroy(result);
+		return false;
+	}
+	*bitmap = result;
+	return true;
+}
@@ -8,10 +8,20 @@
 #include <AvUtils/avProcess.h>
 #include <AvUtils/process/avPipe.h>
 #include <AvUtils/avEnvironment.h>
+#include <AvUtils/util/avHash.h>
+#include <AvUtils/avMath.h>
+#include <AvUtils/util/avBitfield.h>
+#include <AvUtils/util/avRoaringBitmap.h>
+#include <AvUtils/string/avStringMatcher.h>
+#include <AvUtils/string/avChar.h>
+#include <AvUtils/string/avStringIntern.h>
+#include <AvUtils/parsing/avTokenizer.h>
 
 
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
+#include <time.h>
 
 void testQueue() {
 	AvQueue queue;
@@ -61,6 +71,30 @@ void testQueue() {
 	}
 
 	avQueueDestroy(queue);
+
+	avQueueCreateGrowable(sizeof(int), 2, &queue);
+	int values[5] = { 1, 2, 3, 4, 5 };
+	avQueuePushBatch(values, 5, queue);
+	int front = 0;
+	avQueuePushFront(&front, queue);
+	printf("growable queue size: %"PRIu64" filledSlots: %"PRIu64"\n", avQueueGetSize(queue), avQueueGetOccupiedSpace(queue));
+
+	void* first;
+	void* second;
+	uint64 firstCount;
+	uint64 secondCount;
+	avQueuePeekSpans(&first, &firstCount, &second, &secondCount, queue);
+	for (uint64 i = 0; i < firstCount; i++) {
+		printf("%i\n", ((int*)first)[i]);
+	}
+	for (uint64 i = 0; i < secondCount; i++) {
+		printf("%i\n", ((int*)second)[i]);
+	}
+	int back;
+	avQueuePullBack(&back, queue);
+	printf("back: %i\n", back);
+
+	avQueueDestroy(queue);
 }
 
 uint32 threadFuncA(void* data, uint64 dataSize) {
@@ -104,6 +138,29 @@ uint32 mutexFunc(void* data, uint64 dataSize) {
 	return 0;
 }
 
+uint32 sharedStringFunc(void* data, uint64 dataSize) {
+	avStringDebugContextStart;
+	AvStringRef str = (AvStringRef)data;
+	avStringPrintln(*str);
+	avStringFree(str);
+	avStringDebugContextEnd;
+	return 0;
+}
+
+void testSharedString() {
+	AvString original = AV_EMPTY;
+	avStringClone(&original, AV_CSTR("string shared between threads"));
+	AvString shared = AV_EMPTY;
+	avStringShare(&shared, original);
+
+	AvThread thread;
+	avThreadCreate((AvThreadEntry)&sharedStringFunc, &thread);
+	avThreadStart(&shared, sizeof(AvString), thread);
+	avStringFree(&original);
+	avThreadJoin(thread);
+	avThreadDestroy(thread);
+}
+
 void testMutex() {
 	AvThread thread;
 	AvMutex mutex;
@@ -125,6 +182,548 @@ void testMutex() {
 	avThreadDestroy(thread);
 }
 
+uint32 concurrentMapFunc(void* data, uint64 dataSize) {
+	AvConcurrentMap map = (AvConcurrentMap)data;
+	for (uint64 i = 0; i < 1000; i++) {
+		uint64 value = i * 2;
+		avConcurrentMapInsertIfAbsent(&value, &i, nullptr, map);
+	}
+	return 0;
+}
+
+void testConcurrentMap() {
+	AvConcurrentMap map;
+	avConcurrentMapCreate(sizeof(uint64), sizeof(uint64), 0, nullptr, &map);
+
+	AvThread threadA;
+	AvThread threadB;
+	avThreadCreate((AvThreadEntry)&concurrentMapFunc, &threadA);
+	avThreadCreate((AvThreadEntry)&concurrentMapFunc, &threadB);
+	avThreadStart(map, sizeof(AvConcurrentMap), threadA);
+	avThreadStart(map, sizeof(AvConcurrentMap), threadB);
+	avThreadJoin(threadA);
+	avThreadJoin(threadB);
+	avThreadDestroy(threadA);
+	avThreadDestroy(threadB);
+
+	printf("concurrent map count: %"PRIu64"\n", avConcurrentMapGetCount(map));
+
+	uint64 key = 500;
+	uint64 value = 0;
+	if (avConcurrentMapRead(&value, &key, map)) {
+		printf("key %"PRIu64" = %"PRIu64"\n", key, value);
+	}
+	avConcurrentMapRemove(&key, map);
+	if (!avConcurrentMapContains(&key, map)) {
+		printf("key %"PRIu64" removed\n", key);
+	}
+
+	avConcurrentMapDestroy(map);
+}
+
+uint32 concurrentQueueFunc(void* data, uint64 dataSize) {
+	AvSpscQueue queue = (AvSpscQueue)data;
+	for (uint64 i = 0; i < 1000;) {
+		if (avSpscQueuePush(&i, queue)) {
+			i++;
+		} else {
+			avThreadYield();
+		}
+	}
+	return 0;
+}
+
+void testConcurrentQueue() {
+	AvSpscQueue queue;
+	avSpscQueueCreate(sizeof(uint64), 64, &queue);
+
+	AvThread producer;
+	avThreadCreate((AvThreadEntry)&concurrentQueueFunc, &producer);
+	avThreadStart(queue, sizeof(AvSpscQueue), producer);
+
+	uint64 sum = 0;
+	uint64 values[16];
+	for (uint64 received = 0; received < 1000;) {
+		uint64 count = avSpscQueuePullBatch(values, 16, queue);
+		for (uint64 i = 0; i < count; i++) {
+			sum += values[i];
+		}
+		received += count;
+		if (count == 0) {
+			avThreadYield();
+		}
+	}
+	avThreadJoin(producer);
+	avThreadDestroy(producer);
+	printf("spsc queue sum: %"PRIu64"\n", sum);
+	avSpscQueueDestroy(queue);
+}
+
+void testPriorityQueue() {
+	AvPriorityQueue queue;
+	avPriorityQueueCreate(sizeof(uint32), 4, &queue);
+
+	uint32 jobs[] = { 1, 2, 3, 4, 5 };
+	uint64 priorities[] = { 50, 10, 40, 30, 20 };
+	AvPriorityQueueHandle handles[5];
+	for (uint32 i = 0; i < 5; i++) {
+		handles[i] = avPriorityQueuePush(&jobs[i], priorities[i], queue);
+	}
+	avPriorityQueueUpdate(handles[0], 5, queue);
+	avPriorityQueueRemove(handles[2], nullptr, queue);
+
+	uint32 job;
+	uint64 priority;
+	while (avPriorityQueuePop(&job, &priority, queue)) {
+		printf("job %u priority %"PRIu64"\n", job, priority);
+	}
+	avPriorityQueueDestroy(queue);
+}
+
+void timerExpired(void* data, uint64 expiry, void* userData) {
+	printf("timer %u expired at %"PRIu64"\n", *(uint32*)data, expiry);
+}
+
+void testTimerWheel() {
+	AvTimerWheel wheel;
+	avTimerWheelCreate(sizeof(uint32), 0, &wheel);
+
+	uint32 ids[] = { 1, 2, 3 };
+	avTimerWheelInsert(10, &ids[0], wheel);
+	AvTimerHandle cancelled = avTimerWheelInsert(100, &ids[1], wheel);
+	avTimerWheelInsert(5000, &ids[2], wheel);
+	avTimerWheelCancel(cancelled, wheel);
+
+	uint64 next;
+	if (avTimerWheelGetNextExpiry(&next, wheel)) {
+		printf("next timer at %"PRIu64"\n", next);
+	}
+	uint32 fired = avTimerWheelAdvance(10000, timerExpired, nullptr, wheel);
+	printf("timers fired: %u\n", fired);
+	avTimerWheelDestroy(wheel);
+}
+
+void testTable() {
+	AvTable table;
+	avTableCreateLayout(AV_TABLE_LAYOUT_COLUMNS, 2, 100, &table, (uint64)sizeof(int32), (uint64)sizeof(float));
+	for (uint32 i = 0; i < 100; i++) {
+		int32 id = i % 10;
+		float weight = i * 0.5f;
+		avTableWrite(&id, 0, i, table);
+		avTableWrite(&weight, 1, i, table);
+	}
+
+	int64 idSum;
+	double weightSum;
+	float minWeight;
+	float maxWeight;
+	int32 seven = 7;
+	avTableColumnSum(0, AV_TABLE_ELEMENT_TYPE_INT32, &idSum, table);
+	avTableColumnSum(1, AV_TABLE_ELEMENT_TYPE_FLOAT, &weightSum, table);
+	avTableColumnMinMax(1, AV_TABLE_ELEMENT_TYPE_FLOAT, &minWeight, &maxWeight, table);
+	printf("table id sum: %"PRIi64" weight sum: %f min: %f max: %f\n", idSum, weightSum, minWeight, maxWeight);
+	printf("table rows with id 7: %"PRIu64"\n", avTableColumnCountEqual(0, &seven, table));
+
+	avTableCreateIndex(0, AV_TABLE_INDEX_HASH, AV_TABLE_ELEMENT_TYPE_INT32, table);
+	avTableCreateIndex(1, AV_TABLE_INDEX_SORTED, AV_TABLE_ELEMENT_TYPE_FLOAT, table);
+	int32 eight = 8;
+	avTableWrite(&eight, 0, 7, table);
+	printf("indexed rows with id 7: %u\n", avTableFindEqual(0, &seven, nullptr, 0, table));
+
+	uint32 rows[8];
+	float low = 10.0f;
+	float high = 12.0f;
+	uint32 found = avTableFindRange(1, &low, &high, rows, 8, table);
+	for (uint32 i = 0; i < found && i < 8; i++) {
+		printf("row %u in weight range\n", rows[i]);
+	}
+
+	int32 newIds[3] = { 7, 7, 9 };
+	float newWeights[3] = { 1.0f, 2.0f, 3.0f };
+	const void* newColumns[2] = { newIds, newWeights };
+	avTableReserve(200, table);
+	avTableAppendRows(3, newColumns, table);
+	printf("table rows: %u capacity: %u rows with id 7: %u\n", avTableGetRows(table), avTableGetCapacity(table), avTableFindEqual(0, &seven, nullptr, 0, table));
+
+	avTableDestroy(table);
+}
+
+typedef struct StencilPass {
+	AvGrid src;
+	AvGrid dst;
+} StencilPass;
+
+// 5 point average of a cell, every path adds the neighbours in the same order so all layouts give the same result
+static float stencilAverage(float center, float left, float right, float up, float down) {
+	return (center + left + right + up + down) * 0.2f;
+}
+
+static float stencilCell(uint32 x, uint32 y, AvGrid grid) {
+	return stencilAverage(
+		*(float*)avGridGetPtr(x, y, grid),
+		*(float*)avGridGetPtr(x - 1, y, grid),
+		*(float*)avGridGetPtr(x + 1, y, grid),
+		*(float*)avGridGetPtr(x, y - 1, grid),
+		*(float*)avGridGetPtr(x, y + 1, grid));
+}
+
+// the linear layout is walked in row order, which is already the best order for it
+static void stencilRows(StencilPass* pass) {
+	uint32 width = avGridGetWidth(pass->src);
+	uint32 height = avGridGetHeight(pass->src);
+	for (uint32 y = 1; y < height - 1; y++) {
+		const float* up = avGridGetPtr(0, y - 1, pass->src);
+		const float* row = avGridGetPtr(0, y, pass->src);
+		const float* down = avGridGetPtr(0, y + 1, pass->src);
+		float* out = avGridGetPtr(0, y, pass->dst);
+		for (uint32 x = 1; x < width - 1; x++) {
+			out[x] = stencilAverage(row[x], row[x - 1], row[x + 1], up[x], down[x]);
+		}
+	}
+}
+
+// the tiled layouts are processed one tile at a time. in the tiled layout the part of a row inside a tile
+// is contiguous, so every row is read through row pointers and only the cells left and right of the tile
+// are looked up separately. morton tiles have no contiguous rows, their cells are read through the tile
+static bool32 stencilTile(const AvGridTile* tile, void* userData) {
+	StencilPass* pass = userData;
+	AvGridTile src;
+	avGridGetTile(tile->x / AV_GRID_TILE_SIZE, tile->y / AV_GRID_TILE_SIZE, &src, pass->src);
+	uint32 width = avGridGetWidth(pass->src);
+	uint32 height = avGridGetHeight(pass->src);
+	uint32 last = tile->width - 1;
+	for (uint32 y = 0; y < tile->height; y++) {
+		uint32 gy = tile->y + y;
+		if (gy == 0 || gy == height - 1) {
+			continue;
+		}
+		if (src.rowStride) {
+			const float* up = avGridGetPtr(tile->x, gy - 1, pass->src);
+			const float* row = avGridTileGetPtr(0, y, &src);
+			const float* down = avGridGetPtr(tile->x, gy + 1, pass->src);
+			float* out = avGridTileGetPtr(0, y, tile);
+			for (uint32 x = 1; x < last; x++) {
+				out[x] = stencilAverage(row[x], row[x - 1], row[x + 1], up[x], down[x]);
+			}
+			if (tile->x != 0) {
+				out[0] = stencilAverage(row[0], *(float*)avGridGetPtr(tile->x - 1, gy, pass->src), row[1], up[0], down[0]);
+			}
+			if (tile->x + last != width - 1) {
+				out[last] = stencilAverage(row[last], row[last - 1], *(float*)avGridGetPtr(tile->x + tile->width, gy, pass->src), up[last], down[last]);
+			}
+			continue;
+		}
+		bool32 borderRow = y == 0 || y == tile->height - 1;
+		for (uint32 x = 0; x < tile->width; x++) {
+			uint32 gx = tile->x + x;
+			if (gx == 0 || gx == width - 1) {
+				continue;
+			}
+			float* out = avGridTileGetPtr(x, y, tile);
+			if (borderRow || x == 0 || x == last) {
+				*out = stencilCell(gx, gy, pass->src);
+			} else {
+				*out = stencilAverage(
+					*(float*)avGridTileGetPtr(x, y, &src),
+					*(float*)avGridTileGetPtr(x - 1, y, &src),
+					*(float*)avGridTileGetPtr(x + 1, y, &src),
+					*(float*)avGridTileGetPtr(x, y - 1, &src),
+					*(float*)avGridTileGetPtr(x, y + 1, &src));
+			}
+		}
+	}
+	return true;
+}
+
+void testGridLayouts() {
+	const char* names[] = { "linear", "tiled", "morton" };
+	const AvGridLayout layouts[] = { AV_GRID_LAYOUT_LINEAR, AV_GRID_LAYOUT_TILED, AV_GRID_LAYOUT_MORTON };
+	// 64 MB per grid, larger than the last level cache
+	const uint32 size = 4096;
+	const uint32 iterations = 4;
+	double reference = 0;
+	for (uint32 i = 0; i < 3; i++) {
+		StencilPass pass;
+		avGridCreateLayout(layouts[i], sizeof(float), size, size, &pass.src);
+		avGridCreateLayout(layouts[i], sizeof(float), size, size, &pass.dst);
+		float hot = 100.0f;
+		avGridFillRegion(&hot, size / 4, size / 4, size / 2, size / 2, pass.src);
+
+		clock_t start = clock();
+		for (uint32 iteration = 0; iteration < iterations; iteration++) {
+			if (layouts[i] == AV_GRID_LAYOUT_LINEAR) {
+				stencilRows(&pass);
+			} else {
+				avGridForEachTile(stencilTile, &pass, pass.dst);
+			}
+			AvGrid tmp = pass.src;
+			pass.src = pass.dst;
+			pass.dst = tmp;
+		}
+		double time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+		double checksum = 0;
+		for (uint32 y = 0; y < size; y++) {
+			for (uint32 x = 0; x < size; x++) {
+				checksum += *(float*)avGridGetPtr(x, y, pass.src);
+			}
+		}
+		if (i == 0) {
+			reference = checksum;
+		}
+		avAssert(checksum == reference, "every layout must compute the same stencil");
+		printf("grid %s stencil: %.3fs checksum: %f\n", names[i], time, checksum);
+		avGridDestroy(pass.src);
+		avGridDestroy(pass.dst);
+	}
+}
+
+static void fillGridPattern(AvGrid grid) {
+	for (uint32 y = 0; y < avGridGetHeight(grid); y++) {
+		for (uint32 x = 0; x < avGridGetWidth(grid); x++) {
+			uint32 value = y * 1000 + x;
+			avGridWrite(&value, x, y, grid);
+		}
+	}
+}
+
+static uint32 readGridCell(uint32 x, uint32 y, AvGrid grid) {
+	uint32 value;
+	avGridRead(&value, x, y, grid);
+	return value;
+}
+
+void testGridRegions() {
+	const AvGridLayout layouts[] = { AV_GRID_LAYOUT_LINEAR, AV_GRID_LAYOUT_TILED, AV_GRID_LAYOUT_MORTON };
+	// larger than a tile so regions cross tile borders
+	const uint32 size = 70;
+	for (uint32 i = 0; i < 3; i++) {
+		AvGrid grid;
+		avGridCreateLayout(layouts[i], sizeof(uint32), size, size, &grid);
+		fillGridPattern(grid);
+
+		AvGrid extracted = nullptr;
+		avGridExtract(5, 6, 20, 10, grid, &extracted);
+		avAssert(avGridGetWidth(extracted) == 20 && avGridGetHeight(extracted) == 10, "extracted grid has the wrong size");
+		avAssert(avGridGetLayout(extracted) == layouts[i], "extracted grid keeps the layout");
+		avAssert(avGridCompareRegion(grid, 5, 6, 20, 10, extracted, 0, 0), "extracted region differs from the source");
+		avAssert(!avGridCompareRegion(grid, 6, 6, 20, 10, extracted, 0, 0), "shifted regions must differ");
+		avAssert(!avGridCompareRegion(grid, 5, 6, 21, 10, extracted, 0, 0), "regions that do not fit must not compare equal");
+		avAssert(!avGridCompareRegion(grid, size - 10, 0, 20, 10, extracted, 0, 0), "regions that do not fit must not compare equal");
+		uint32 changed = 1;
+		avGridWrite(&changed, 19, 9, extracted);
+		avAssert(!avGridCompareRegion(grid, 5, 6, 20, 10, extracted, 0, 0), "a changed cell must be detected");
+		avGridDestroy(extracted);
+
+		// extracting past the edge clips, extracting outside the grid does nothing
+		avGridExtract(size - 10, size - 5, 20, 20, grid, &extracted);
+		avAssert(avGridGetWidth(extracted) == 10 && avGridGetHeight(extracted) == 5, "extracted region is not clipped");
+		avAssert(avGridCompareRegion(grid, size - 10, size - 5, 10, 5, extracted, 0, 0), "clipped extract differs from the source");
+		avGridDestroy(extracted);
+		extracted = nullptr;
+		avGridExtract(size, 0, 10, 10, grid, &extracted);
+		avAssert(extracted == nullptr, "extracting outside the grid must not create a grid");
+
+		// overlapping copies within one grid, in every direction, against a snapshot of the source
+		const int32 offsets[][2] = { { 5, 3 }, { -5, -3 }, { 7, 0 }, { -7, 0 }, { 0, 4 }, { 0, -4 }, { 3, -2 } };
+		for (uint32 o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+			fillGridPattern(grid);
+			AvGrid snapshot;
+			avGridExtract(0, 0, size, size, grid, &snapshot);
+			uint32 srcX = 10;
+			uint32 srcY = 10;
+			uint32 dstX = srcX + offsets[o][0];
+			uint32 dstY = srcY + offsets[o][1];
+			avGridCopyRegion(grid, srcX, srcY, 40, 30, grid, dstX, dstY);
+			avAssert(avGridCompareRegion(snapshot, srcX, srcY, 40, 30, grid, dstX, dstY), "overlapping copy corrupted the region");
+			// cells outside the destination keep their value
+			avAssert(readGridCell(dstX - 1, dstY, grid) == (dstY * 1000 + dstX - 1), "overlapping copy wrote left of the region");
+			avAssert(readGridCell(dstX + 40, dstY + 29, grid) == ((dstY + 29) * 1000 + dstX + 40), "overlapping copy wrote right of the region");
+			avGridDestroy(snapshot);
+		}
+
+		// copies are clipped to both the source and the destination
+		fillGridPattern(grid);
+		AvGrid other;
+		avGridCreateLayout(layouts[(i + 1) % 3], sizeof(uint32), 30, 20, &other);
+		avGridCopyRegion(grid, 0, 0, 50, 50, other, 25, 15);
+		avAssert(avGridCompareRegion(grid, 0, 0, 5, 5, other, 25, 15), "copy clipped to the destination differs");
+		avAssert(readGridCell(24, 15, other) == 0 && readGridCell(25, 14, other) == 0, "clipped copy wrote outside the region");
+		avGridCopyRegion(grid, size - 4, size - 3, 20, 20, other, 0, 0);
+		avAssert(avGridCompareRegion(grid, size - 4, size - 3, 4, 3, other, 0, 0), "copy clipped to the source differs");
+		avAssert(readGridCell(4, 0, other) == 0 && readGridCell(0, 3, other) == 0, "clipped copy read past the source");
+		avGridCopyRegion(grid, 0, 0, 10, 10, other, 30, 0);
+		avGridCopyRegion(grid, size, 0, 10, 10, other, 10, 10);
+		avAssert(readGridCell(10, 10, other) == 0, "copies outside the grids must not write");
+		avGridDestroy(other);
+
+		// fills are clipped to the grid
+		uint32 fill = 7;
+		avGridFillRegion(&fill, size - 3, size - 2, 10, 10, grid);
+		uint32 filled = 0;
+		for (uint32 y = 0; y < size; y++) {
+			for (uint32 x = 0; x < size; x++) {
+				bool32 inside = x >= size - 3 && y >= size - 2;
+				uint32 value = readGridCell(x, y, grid);
+				avAssert(inside ? value == fill : value == y * 1000 + x, "fill wrote outside the region");
+				filled += inside;
+			}
+		}
+		avAssert(filled == 6, "clipped fill covers the wrong amount of cells");
+		avGridFillRegion(nullptr, 1, 2, 17, 3, grid);
+		for (uint32 y = 2; y < 5; y++) {
+			for (uint32 x = 1; x < 18; x++) {
+				avAssert(readGridCell(x, y, grid) == 0, "filling with nullptr must clear the region");
+			}
+		}
+		avAssert(readGridCell(18, 2, grid) == 2018 && readGridCell(0, 2, grid) == 2000, "clearing wrote outside the region");
+		avGridFillRegion(&fill, size, 0, 10, 10, grid);
+		avGridDestroy(grid);
+	}
+	printf("grid region copy, compare, extract and fill passed\n");
+}
+
+typedef struct GridMarker {
+	byte value[8];
+	uint64 size;
+} GridMarker;
+
+static bool32 isGridMarker(const void* cell, void* userData) {
+	GridMarker* marker = userData;
+	return memcmp(cell, marker->value, marker->size) == 0;
+}
+
+typedef struct GridRowCheck {
+	AvGrid grid;
+	uint32 rows;
+	uint32 stopAt;
+} GridRowCheck;
+
+static bool32 checkGridRow(const void* row, uint32 width, uint32 y, void* userData) {
+	GridRowCheck* check = userData;
+	uint64 elementSize = avGridGetElementSize(check->grid);
+	avAssert(width == avGridGetWidth(check->grid), "scanned row has the wrong width");
+	for (uint32 x = 0; x < width; x++) {
+		avAssert(memcmp((const byte*)row + x * elementSize, avGridGetPtr(x, y, check->grid), elementSize) == 0, "scanned row differs from the grid");
+	}
+	check->rows++;
+	return y != check->stopAt;
+}
+
+void testGridFind() {
+	const AvGridLayout layouts[] = { AV_GRID_LAYOUT_LINEAR, AV_GRID_LAYOUT_TILED, AV_GRID_LAYOUT_MORTON };
+	const uint64 elementSizes[] = { 1, 2, 4, 8 };
+	// widths around the 16 byte blocks of the row search, most are not a multiple of 16
+	const uint32 widths[] = { 1, 3, 15, 16, 17, 33, 70, 131 };
+	const uint32 height = 9;
+	uint32 seed = 12345;
+	for (uint32 l = 0; l < 3; l++) {
+		for (uint32 s = 0; s < sizeof(elementSizes) / sizeof(elementSizes[0]); s++) {
+			uint64 elementSize = elementSizes[s];
+			GridMarker marker = { .size = elementSize };
+			memset(marker.value, 0x5a, sizeof(marker.value));
+			// differs from the marker in its last byte only, so a partial lane match is a false positive
+			byte nearMiss[8];
+			memcpy(nearMiss, marker.value, sizeof(nearMiss));
+			nearMiss[elementSize - 1] = 0x5b;
+			for (uint32 w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+				uint32 width = widths[w];
+				AvGrid grid;
+				avGridCreateLayout(layouts[l], elementSize, width, height, &grid);
+
+				uint32 xMin, yMin, xMax, yMax;
+				avGridFindMinRectSurrounding(marker.value, &xMin, &yMin, &xMax, &yMax, grid);
+				avAssert(xMin == width && yMin == height && xMax == 0 && yMax == 0, "empty grid must report no rect");
+				avAssert(!avGridFindMinRectMatching(isGridMarker, &marker, &xMin, &yMin, &xMax, &yMax, grid), "empty grid must not match");
+
+				for (uint32 trial = 0; trial < 16; trial++) {
+					avGridClear(nullptr, grid);
+					avGridFillRegion(nearMiss, 0, 0, width, height, grid);
+					uint32 expectedXMin = width;
+					uint32 expectedYMin = height;
+					uint32 expectedXMax = 0;
+					uint32 expectedYMax = 0;
+					// the first trials hit the edges of the grid, the rest are random cells
+					uint32 cells = trial < 2 ? 1 : 1 + trial % 4;
+					for (uint32 c = 0; c < cells; c++) {
+						seed = seed * 1103515245 + 12345;
+						uint32 x = trial == 0 ? width - 1 : trial == 1 ? 0 : (seed >> 8) % width;
+						uint32 y = trial == 0 ? height - 1 : trial == 1 ? 0 : (seed >> 20) % height;
+						avGridWrite(marker.value, x, y, grid);
+						expectedXMin = AV_MIN(expectedXMin, x);
+						expectedYMin = AV_MIN(expectedYMin, y);
+						expectedXMax = AV_MAX(expectedXMax, x);
+						expectedYMax = AV_MAX(expectedYMax, y);
+					}
+					avGridFindMinRectSurrounding(marker.value, &xMin, &yMin, &xMax, &yMax, grid);
+					avAssert(xMin == expectedXMin && yMin == expectedYMin && xMax == expectedXMax && yMax == expectedYMax, "surrounding rect is wrong");
+					avAssert(avGridFindMinRectMatching(isGridMarker, &marker, &xMin, &yMin, &xMax, &yMax, grid), "matching rect must be found");
+					avAssert(xMin == expectedXMin && yMin == expectedYMin && xMax == expectedXMax && yMax == expectedYMax, "matching rect is wrong");
+				}
+
+				GridRowCheck check = { .grid = grid, .stopAt = height };
+				avAssert(avGridScanRows(0, height + 10, checkGridRow, &check, grid) == height && check.rows == height, "scan must visit every row");
+				check = (GridRowCheck) { .grid = grid, .stopAt = 4 };
+				avAssert(avGridScanRows(2, height, checkGridRow, &check, grid) == 3 && check.rows == 3, "scan must stop when the callback returns false");
+				avAssert(avGridScanRows(height, height + 1, checkGridRow, &check, grid) == 0, "scan outside the grid must not visit rows");
+				avGridDestroy(grid);
+			}
+		}
+	}
+	printf("grid rect search and row scan passed\n");
+}
+
+void testSparseGrid() {
+	AvSparseGrid grid;
+	int32 empty = -1;
+	avSparseGridCreate(sizeof(int32), &empty, &grid);
+	for (int32 i = 0; i < 1000; i++) {
+		avSparseGridWrite(&i, 1000000 + i * 997, 2000000 + i * 131, grid);
+	}
+	int32 value;
+	avSparseGridRead(&value, 1000000 + 5 * 997, 2000000 + 5 * 131, grid);
+	printf("sparse grid value: %i ", value);
+	avSparseGridRead(&value, 12345678, 87654321, grid);
+	printf("untouched value: %i chunks: %u memory: %"PRIu64"\n", value, avSparseGridGetChunkCount(grid), avSparseGridGetMemoryUsage(grid));
+	avSparseGridDestroy(grid);
+}
+
+void testBitField() {
+	AvBitField nodes;
+	AvBitField visited;
+	avBitFieldCreate(1000000, &nodes);
+	avBitFieldCreate(1000000, &visited);
+	for (uint32 i = 0; i < 1000000; i += 1000) {
+		avBitFieldSet(i, nodes);
+	}
+	avBitFieldSet(5000, visited);
+	avBitFieldAndNot(nodes, visited);
+	printf("bitfield ones: %u first: %u next after 4001: %u first clear: %u\n", avBitFieldCountOnes(nodes),
+		avBitFieldFindFirstSet(nodes), avBitFieldFindNextSet(4001, nodes), avBitFieldFindFirstClear(nodes));
+	avBitFieldDestroy(&nodes);
+	avBitFieldDestroy(&visited);
+}
+
+void testRoaringBitmap() {
+	AvRoaringBitmap dependencies;
+	AvRoaringBitmap resolved;
+	avRoaringBitmapCreate(&dependencies);
+	avRoaringBitmapCreate(&resolved);
+	for (uint32 i = 0; i < 100000; i++) {
+		avRoaringBitmapAdd(i * 40000, dependencies);
+	}
+	avRoaringBitmapAddRange(1000000, 2000000, dependencies);
+	avRoaringBitmapAddRange(0, 1500000, resolved);
+	avRoaringBitmapAndNot(dependencies, resolved);
+	avRoaringBitmapRunOptimize(dependencies);
+	uint32 minimum = 0;
+	avRoaringBitmapGetMinimum(&minimum, dependencies);
+	printf("roaring cardinality: %"PRIu64" minimum: %u memory: %"PRIu64" serialized: %"PRIu64"\n", avRoaringBitmapGetCardinality(dependencies),
+		minimum, avRoaringBitmapGetMemoryUsage(dependencies), avRoaringBitmapGetSerializedSize(dependencies));
+	avRoaringBitmapDestroy(dependencies);
+	avRoaringBitmapDestroy(resolved);
+}
+
 void testDynamicArray() {
 
 	AvDynamicArray arr;
@@ -202,6 +801,230 @@ void testDynamicArray() {
 }
 
 
+void testStringDebugStats() {
+	avStringDebugContextStart;
+	AvStringDebugStats stats;
+	avAssert(avStringDebugContextGetStats(&stats), "a debug context is active");
+	avAssert(stats.liveCount == 0 && stats.totalAllocations == 0, "a new context starts empty");
+
+	AvString first = AV_EMPTY;
+	AvString second = AV_EMPTY;
+	avStringClone(&first, AV_CSTR("a string long enough to be stored outside the memory"));
+	avStringClone(&second, AV_CSTR("short"));
+	avStringDebugContextGetStats(&stats);
+	avAssert(stats.liveCount == 2 && stats.totalAllocations == 2, "clones must be counted in the active context");
+	uint64 cloneBytes = first.len + second.len;
+	avAssert(stats.liveBytes == cloneBytes, "clones must be counted with their size");
+
+	// a nested context counts its own allocations, the enclosing context does not see them
+	avStringDebugContextStart;
+	AvString inner = AV_EMPTY;
+	avStringClone(&inner, AV_CSTR("inner"));
+	avStringDebugContextGetStats(&stats);
+	avAssert(stats.liveCount == 1 && stats.totalAllocations == 1 && stats.liveBytes == inner.len, "clones must be counted in the innermost context");
+	avStringFree(&inner);
+	avStringDebugContextGetStats(&stats);
+	avAssert(stats.liveCount == 0 && stats.liveBytes == 0 && stats.peakCount == 1, "freeing must be counted in the innermost context");
+	avStringDebugContextEnd;
+
+	avStringDebugContextGetStats(&stats);
+	avAssert(stats.liveCount == 2 && stats.totalAllocations == 2, "the nested context must not change the enclosing one");
+	avStringFree(&first);
+	avStringFree(&second);
+	avStringDebugContextGetStats(&stats);
+	avAssert(stats.liveCount == 0 && stats.liveBytes == 0, "every clone has been freed");
+	avAssert(stats.peakCount == 2 && stats.peakBytes == cloneBytes, "peaks must survive freeing");
+	avStringDebugContextEnd;
+	printf("string debug stats passed\n");
+}
+
+static strOffset naiveFindFirst(const char* str, uint64 length, const char* find, uint64 findLength, uint64 start) {
+	for (uint64 i = start; i + findLength <= length; i++) {
+		if (memcmp(str + i, find, findLength) == 0) {
+			return i;
+		}
+	}
+	return AV_STRING_NULL;
+}
+
+static strOffset naiveFindLast(const char* str, uint64 length, const char* find, uint64 findLength) {
+	for (uint64 i = length - findLength + 1; findLength <= length && i > 0; i--) {
+		if (memcmp(str + i - 1, find, findLength) == 0) {
+			return i - 1;
+		}
+	}
+	return AV_STRING_NULL;
+}
+
+void testStringSearch() {
+	// needles for the single character, short and long needle search
+	const uint64 needleLengths[] = { 1, 2, 7, 16, 31, 32, 33, 47, 80 };
+	char haystack[256];
+	char needle[96];
+	char filler[64];
+	memset(filler, '.', sizeof(filler));
+	for (uint32 n = 0; n < sizeof(needleLengths) / sizeof(needleLengths[0]); n++) {
+		uint64 needleLength = needleLengths[n];
+		for (uint64 i = 0; i < needleLength; i++) {
+			needle[i] = 'a' + i % 26;
+		}
+		AvString find = AV_STR(needle, needleLength);
+
+		// a match cut off by the end of the string must not be found
+		uint64 length = 0;
+		memcpy(haystack, filler, 50);
+		length += 50;
+		memcpy(haystack + length, needle, needleLength - 1);
+		length += needleLength - 1;
+		AvString cut = AV_STR(haystack, length);
+		avAssert(avStringFindFirstOccuranceOf(cut, find) == AV_STRING_NULL, "partial match at the end must not be found");
+		avAssert(avStringFindLastOccuranceOf(cut, find) == AV_STRING_NULL, "partial match at the end must not be found");
+		avAssert(avStringFindCount(cut, find) == 0, "partial match at the end must not be counted");
+
+		// a match ending exactly at the end of the string is the last possible position
+		memcpy(haystack + length, needle + needleLength - 1, 1);
+		length = 50 + needleLength;
+		AvString atEnd = AV_STR(haystack + 50 - 13, length - 50 + 13);
+		avAssert(avStringFindFirstOccuranceOf(atEnd, find) == 13, "match at the end must be found");
+		avAssert(avStringFindLastOccuranceOf(atEnd, find) == 13, "last match must start at the match, not one past it");
+		avAssert(avStringFindCount(atEnd, find) == 1, "match at the end must be counted");
+		AvString exact = AV_STR(haystack + 50, needleLength);
+		avAssert(avStringFindLastOccuranceOf(exact, find) == 0, "a string equal to the needle must match at 0");
+
+		// a failed prefix directly followed by the needle
+		memcpy(haystack, needle, needleLength - 1);
+		memcpy(haystack + needleLength - 1, needle, needleLength);
+		memcpy(haystack + needleLength * 2 - 1, needle, needleLength);
+		AvString afterPrefix = AV_STR(haystack, needleLength * 3 - 1);
+		avAssert(avStringFindFirstOccuranceOf(afterPrefix, find) == needleLength - 1, "match after a failed prefix must be found");
+		avAssert(avStringFindLastOccuranceOf(afterPrefix, find) == needleLength * 2 - 1, "last of two adjacent matches is wrong");
+		avAssert(avStringFindCount(afterPrefix, find) == 2, "matches after a failed prefix must be counted");
+	}
+
+	// overlapping candidates from a two letter alphabet, compared with a naive search for
+	// haystacks crossing the 16 and 32 byte blocks
+	uint32 seed = 42;
+	for (uint64 length = 0; length < 100; length++) {
+		for (uint32 n = 0; n < sizeof(needleLengths) / sizeof(needleLengths[0]); n++) {
+			uint64 needleLength = needleLengths[n];
+			for (uint32 trial = 0; trial < 4; trial++) {
+				for (uint64 i = 0; i < length; i++) {
+					seed = seed * 1103515245 + 12345;
+					haystack[i] = (seed >> 16) % 4 ? 'a' : 'b';
+				}
+				// needles of only a with a trailing b make every run of a a failed prefix
+				memset(needle, 'a', needleLength);
+				needle[needleLength - 1] = trial % 2 ? 'b' : 'a';
+				if (length >= needleLength && trial >= 2) {
+					memcpy(haystack + length - needleLength, needle, needleLength);
+				}
+				AvString str = AV_STR(haystack, length);
+				AvString find = AV_STR(needle, needleLength);
+				avAssert(avStringFindFirstOccuranceOf(str, find) == naiveFindFirst(haystack, length, needle, needleLength, 0), "first occurrence differs from the naive search");
+				avAssert(avStringFindLastOccuranceOf(str, find) == naiveFindLast(haystack, length, needle, needleLength), "last occurrence differs from the naive search");
+				uint64 count = 0;
+				for (strOffset offset = naiveFindFirst(haystack, length, needle, needleLength, 0); offset != AV_STRING_NULL; offset = naiveFindFirst(haystack, length, needle, needleLength, offset + needleLength)) {
+					count++;
+				}
+				avAssert(avStringFindCount(str, find) == count, "count differs from the naive search");
+			}
+		}
+	}
+	printf("string search passed\n");
+}
+
+static bool32 isInCharSet(char chr, AvString chars) {
+	return chars.len != 0 && memchr(chars.chrs, chr, chars.len) != nullptr;
+}
+
+void testStringCharSearch() {
+	// sets that use the single character search, the vector search and the table fallback
+	const AvString sets[] = {
+		AV_CSTR(""),
+		AV_CSTR(":"),
+		AV_CSTR(":;\xe9"),
+		AV_CSTR("0123456789abcdef"),
+		AV_CSTR("0123456789abcdefg"),
+	};
+	char haystack[128];
+	uint32 seed = 7;
+	// lengths crossing the 16 and 32 byte blocks
+	for (uint64 length = 0; length < 100; length++) {
+		for (uint32 s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+			AvString chars = sets[s];
+			for (uint32 trial = 0; trial < 8; trial++) {
+				for (uint64 i = 0; i < length; i++) {
+					seed = seed * 1103515245 + 12345;
+					// the first trial has no matches, later trials get denser
+					bool32 hit = trial != 0 && chars.len && (seed >> 16) % 64 < trial * trial;
+					haystack[i] = hit ? chars.chrs[(seed >> 8) % chars.len] : (i % 2 ? '.' : 'Z');
+				}
+				strOffset first = AV_STRING_NULL;
+				strOffset last = AV_STRING_NULL;
+				for (uint64 i = 0; i < length; i++) {
+					if (isInCharSet(haystack[i], chars)) {
+						first = first == AV_STRING_NULL ? i : first;
+						last = i;
+					}
+				}
+				AvString str = AV_STR(haystack, length);
+				avAssert(avStringFindFirstOccuranceOfAny(str, chars) == first, "first occurrence of any differs from the naive search");
+				avAssert(avStringFindLastOccuranceOfAny(str, chars) == last, "last occurrence of any differs from the naive search");
+			}
+		}
+	}
+
+	// a split on n separators gives n + 1 fields, including empty fields at the ends
+	for (uint64 length = 1; length < 100; length++) {
+		uint32 separators = 0;
+		for (uint64 i = 0; i < length; i++) {
+			seed = seed * 1103515245 + 12345;
+			haystack[i] = (seed >> 16) % 5 ? 'a' + i % 26 : ':';
+			separators += haystack[i] == ':';
+		}
+		AvString str = AV_STR(haystack, length);
+		AV_DS(AvArray, AvString) fields = AV_EMPTY;
+		uint32 count = avStringSplitOnChar(&fields, ':', str);
+		avAssert(count == separators + 1, "split must return the number of fields");
+		avAssert(fields.count == count, "split must fill every field");
+		uint64 position = 0;
+		for (uint32 i = 0; i < count; i++) {
+			AvString field = *(AvString*)avArrayGetPtr(i, &fields);
+			avAssert(field.len == 0 || memcmp(field.chrs, haystack + position, field.len) == 0, "field differs from the string");
+			position += field.len;
+			avAssert(i == count - 1 ? position == length : haystack[position] == ':', "fields must end at a separator");
+			position++;
+		}
+		avArrayFree(&fields);
+	}
+	printf("string char search and split passed\n");
+}
+
+void testStringReplace() {
+	AvString replaced = AV_EMPTY;
+	// every character replaced by nothing leaves an empty string
+	avAssert(avStringReplace(&replaced, AV_CSTR("aa"), AV_CSTR("a"), AV_CSTR("")) == 2, "both characters must be replaced");
+	avAssert(replaced.len == 0, "replacing everything with nothing must give an empty string");
+	avStringFree(&replaced);
+	avAssert(avStringReplace(&replaced, AV_CSTR("abcabc"), AV_CSTR("abc"), AV_CSTR("")) == 2, "both sequences must be replaced");
+	avAssert(replaced.len == 0, "replacing everything with nothing must give an empty string");
+	avStringFree(&replaced);
+
+	avAssert(avStringReplace(&replaced, AV_CSTR("a_b_"), AV_CSTR("_"), AV_CSTR(" insert ")) == 2, "both separators must be replaced");
+	avAssert(avStringEquals(replaced, AV_CSTR("a insert b insert ")), "growing replacement is wrong");
+	avStringFree(&replaced);
+	avAssert(avStringReplace(&replaced, AV_CSTR("xaaay"), AV_CSTR("aa"), AV_CSTR("b")) == 1, "matches must not overlap");
+	avAssert(avStringEquals(replaced, AV_CSTR("xbay")), "shrinking replacement is wrong");
+	avStringFree(&replaced);
+	avAssert(avStringReplace(&replaced, AV_CSTR("abc"), AV_CSTR("d"), AV_CSTR("e")) == 0, "nothing must be replaced");
+	avAssert(avStringEquals(replaced, AV_CSTR("abc")), "a string without matches must be copied");
+	avStringFree(&replaced);
+	avAssert(avStringReplace(&replaced, AV_CSTR("abc"), AV_CSTR(""), AV_CSTR("e")) == 0, "an empty sequence must not match");
+	avAssert(avStringEquals(replaced, AV_CSTR("abc")), "a string without matches must be copied");
+	avStringFree(&replaced);
+	printf("string replace passed\n");
+}
+
 void testString() {
 
 	avStringDebugContextStart;
@@ -240,13 +1063,109 @@ void testString() {
 
 	avArrayFree(&strings);
 
+	AvStringSplitIterator lines;
+	avStringSplitIteratorCreateOnChar(AV_CSTR("first line\n\nsecond line\n"), '\n', 0, AV_STRING_SPLIT_SKIP_EMPTY, &lines);
+	AvString line;
+	while (avStringSplitNext(&line, &lines)) {
+		avStringPrintln(line);
+	}
+
+	AvStringBuilder builder;
+	avStringBuilderCreate(0, &builder);
+	for (char c = 'a'; c <= 'z'; c++) {
+		avStringBuilderAppendChar(c, &builder);
+	}
+	avStringBuilderAppendf(&builder, AV_CSTR(" %u letters"), 26);
+	AvString built = AV_EMPTY;
+	avStringBuilderFinish(&built, &builder);
+	avStringPrintln(built);
+	avStringFree(&built);
+
+	AvString placeholders[] = { AV_CSTR("{name}"), AV_CSTR("{n}"), AV_CSTR("{count}") };
+	AvString values[] = { AV_CSTR("matcher"), AV_CSTR("3"), AV_CSTR("three") };
+	AvStringMatcher matcher;
+	avStringMatcherCreate(3, sizeof(AvString), placeholders, &matcher);
+	AvString expanded = AV_EMPTY;
+	uint64 replaced = avStringMatcherReplace(&expanded, AV_CSTR("{name} replaced {n} ({count}) placeholders"), sizeof(AvString), values, matcher);
+	printf("%"PRIu64" replaced: ", replaced);
+	avStringPrintln(expanded);
+	avStringFree(&expanded);
+	avStringMatcherDestroy(matcher);
+
 	avStringPrintf(AV_CSTR("%hu %08hi %x %p\n%c %5S %09s\n"), 0xffaa, 0xffab, 0xffac, &strings, 'c', AV_CSTR("1234"), "1234");
 	printf("%hu %08hi %x %p\n%c %5s %9s\n", 0xffaa, 0xffab, 0xffac, &strings, 'c', AV_CSTR("1234").chrs, "1234");
 	fflush(stdout);
 
+	printf("case insensitive equal: %i, compare: %i\n",
+		avStringEqualsCaseInsensitive(AV_CSTR("Src/AvUtils/avString.c"), AV_CSTR("src/avutils/AVSTRING.C")),
+		avStringCompareCaseInsensitive(AV_CSTR("Alpha"), AV_CSTR("beta")));
+
+	AvString source = AV_CSTR("identifier_42 = value");
+	printf("leading identifier length: %"PRIu64"\n", avStringSpanClass(source, AV_CHAR_IDENTIFIER));
+
+	AvStringDebugStats stats;
+	if (avStringDebugContextGetStats(&stats)) {
+		printf("string memory: %u live, %u peak, %"PRIu64" allocations\n", stats.liveCount, stats.peakCount, stats.totalAllocations);
+	}
+
 	avStringDebugContextEnd;
 }
 
+void testStringIntern() {
+	AvStringInternPool pool;
+	avStringInternPoolCreate(false, &pool);
+
+	char buffer[] = "path/to/file";
+	AvString first = avStringIntern(AV_CSTR("path/to/file"), pool);
+	AvString second = avStringIntern(AV_CSTR(buffer), pool);
+	AvString other = avStringIntern(AV_CSTR("path/to/other"), pool);
+	avAssert(avStringInternEquals(first, second), "interning equal strings must return the same pointer");
+	avAssert(!avStringInternEquals(first, other), "interning different strings must return different pointers");
+	avAssert(avStringInternPoolGetCount(pool) == 2, "duplicates must only be stored once");
+
+	AvTokenRule rules[] = {
+		{ .type = AV_TOKEN_RULE_TYPE_VALID_CHARS, .text = AV_CSTR("abcdefghijklmnopqrstuvwxyz_"), .tokenType = 0 },
+		{ .type = AV_TOKEN_RULE_TYPE_EXACT, .text = AV_CSTR("="), .tokenType = 1 },
+		{ .type = AV_TOKEN_RULE_TYPE_EXACT, .text = AV_CSTR(";"), .tokenType = 2 },
+	};
+	AvString source = AV_CSTR("name = value;\nvalue = name;\n");
+	AV_DS(AvArray, AvToken) cloned = AV_EMPTY;
+	AV_DS(AvArray, AvToken) interned = AV_EMPTY;
+	AvTokenizeResult clonedResult = avTokenizeString(source, &cloned, 3, rules);
+	AvTokenizeResult internedResult = avTokenizeStringInterned(source, &interned, 3, rules, pool);
+	avAssert(clonedResult.code == AV_TOKENIZE_RESULT_OK && internedResult.code == AV_TOKENIZE_RESULT_OK, "tokenizing failed");
+	avAssert(cloned.count == interned.count, "interned tokenizing must produce the same tokens");
+	for (uint32 i = 0; i < cloned.count; i++) {
+		AvToken* clonedToken = avArrayGetPtr(i, &cloned);
+		AvToken* internedToken = avArrayGetPtr(i, &interned);
+		avAssert(avStringEquals(clonedToken->text, internedToken->text), "interned token text differs");
+		avAssert(clonedToken->type == internedToken->type, "interned token type differs");
+		avAssert(clonedToken->line == internedToken->line && clonedToken->character == internedToken->character, "interned token position differs");
+	}
+	// "name" is the first and the last identifier
+	AvToken* firstName = avArrayGetPtr(0, &interned);
+	AvToken* lastName = avArrayGetPtr(interned.count - 2, &interned);
+	avAssert(avStringInternEquals(firstName->text, lastName->text), "repeated tokens must share the interned text");
+	printf("interned %u tokens into %u strings\n", interned.count, avStringInternPoolGetCount(pool));
+
+	avArrayFree(&cloned);
+	avArrayFree(&interned);
+	avStringInternPoolDestroy(pool);
+}
+
+void testHash() {
+	AvString str = AV_CSTR("hash this string");
+	printf("avStringHash: %016"PRIx64"\n", avStringHash(str));
+
+	AvHashState state;
+	avHashStateInit(AV_HASH_DEFAULT_SEED, &state);
+	avHashStateUpdate(str.chrs, 5, &state);
+	avHashStateUpdate(str.chrs + 5, str.len - 5, &state);
+	printf("streamed hash: %016"PRIx64"\n", avHashStateFinal(&state));
+
+	printf("crc32c: %08"PRIx32"\n", avCrc32c("123456789", 9, 0));
+}
+
 void testPath(const char* location) {
 	avStringDebugContextStart;
 	AvPath path = AV_EMPTY;
@@ -410,9 +1329,27 @@ int main() {
 	testQueue();
 	testThread();
 	testMutex();
+	testSharedString();
+	testConcurrentMap();
+	testConcurrentQueue();
+	testPriorityQueue();
+	testTimerWheel();
+	testTable();
+	testGridLayouts();
+	testGridRegions();
+	testGridFind();
+	testSparseGrid();
+	testBitField();
+	testRoaringBitmap();
 	testPipe();
 	testPath("/");
 	testString();
+	testStringSearch();
+	testStringReplace();
+	testStringCharSearch();
+	testStringIntern();
+	testStringDebugStats();
+	testHash();
 	testProcess();
 	testFile();
 	testEnvironment();